@@ -21,6 +21,7 @@
 /// Uses Dart FFI to interact directly with native FFmpeg libraries for high performance.
 library;
 
+export 'src/abr_ladder.dart';
 export 'src/callback_manager.dart'
     show
         FFmpegSessionCompleteCallback,
@@ -29,25 +30,45 @@ export 'src/callback_manager.dart'
         FFprobeSessionCompleteCallback,
         FFplaySessionCompleteCallback;
 export 'src/chapter_information.dart';
+export 'src/fast_probe.dart';
 export 'src/ffmpeg_kit.dart';
 export 'src/ffmpeg_kit_config.dart';
 export 'src/ffmpeg_kit_extended.dart';
+export 'src/ffmpeg_memory_file.dart';
+export 'src/ffmpeg_pipe.dart';
+export 'src/ffmpeg_process_pool.dart';
 export 'src/ffmpeg_session.dart';
 export 'src/ffplay_android_surface.dart';
+export 'src/ffplay_audio_tap.dart';
 export 'src/ffplay_desktop_texture.dart';
+export 'src/ffplay_event.dart';
 export 'src/ffplay_kit.dart';
 export 'src/ffplay_kit_android.dart';
+export 'src/ffplay_live.dart';
+export 'src/ffplay_playlist.dart';
+export 'src/ffplay_prepare.dart';
+export 'src/ffplay_seek.dart';
 export 'src/ffplay_session.dart';
 export 'src/ffplay_surface.dart';
 export 'src/ffplay_view.dart';
 export 'src/ffprobe_kit.dart';
 export 'src/ffprobe_session.dart';
+export 'src/image_batch_worker.dart';
+export 'src/keyframe_index.dart';
+export 'src/live_output.dart';
 export 'src/log.dart';
 export 'src/media_information.dart';
+export 'src/media_information_cache.dart';
 export 'src/media_information_session.dart';
+export 'src/media_pipeline.dart';
+export 'src/media_probe_pool.dart';
+export 'src/playback_clock.dart';
+export 'src/read_ahead_input.dart';
 export 'src/session.dart';
 export 'src/session_queue_manager.dart'
     show SessionQueueManager, SessionCancelledException;
 export 'src/signal.dart';
 export 'src/statistics.dart';
 export 'src/stream_information.dart';
+export 'src/transcode_cache.dart';
+export 'src/write_behind_output.dart';
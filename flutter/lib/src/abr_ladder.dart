@@ -0,0 +1,507 @@
+/*
+ * FFmpegKit Flutter Extended Plugin - A wrapper library for FFmpeg
+ * Copyright (C) 2026 Akash Patel
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+import 'dart:async';
+import 'dart:convert';
+import 'dart:developer';
+import 'dart:io';
+
+import 'package:path/path.dart' as p;
+
+import 'callback_manager.dart';
+import 'ffmpeg_session.dart';
+import 'session.dart';
+
+/// Container produced by an [AbrLadder].
+enum AbrFormat {
+  /// HLS with one media playlist per rendition and a `master.m3u8`.
+  hls,
+
+  /// MPEG-DASH with a single `manifest.mpd`.
+  dash,
+
+  /// One progressive MP4 file per rendition.
+  mp4,
+}
+
+/// A single rung of an [AbrLadder].
+class Rendition {
+  /// Name used for the output directory or file (e.g. `720p`).
+  final String name;
+
+  /// Output height in pixels.
+  final int height;
+
+  /// Output width in pixels; `null` preserves the source aspect ratio.
+  final int? width;
+
+  /// Target video bitrate in kbit/s.
+  final int videoBitrateKbps;
+
+  /// Peak video bitrate in kbit/s; defaults to 107% of [videoBitrateKbps].
+  final int? maxBitrateKbps;
+
+  /// Target audio bitrate in kbit/s.
+  final int audioBitrateKbps;
+
+  /// Video encoder name.
+  final String videoCodec;
+
+  /// Audio encoder name.
+  final String audioCodec;
+
+  /// Additional per-output video encoder options (e.g. `{'preset': 'fast'}`).
+  final Map<String, String> videoOptions;
+
+  /// Creates a new [Rendition].
+  const Rendition({
+    required this.name,
+    required this.height,
+    required this.videoBitrateKbps,
+    this.width,
+    this.maxBitrateKbps,
+    this.audioBitrateKbps = 128,
+    this.videoCodec = 'libx264',
+    this.audioCodec = 'aac',
+    this.videoOptions = const {},
+  });
+
+  int get _maxRate => maxBitrateKbps ?? (videoBitrateKbps * 1.07).round();
+}
+
+/// Encoder statistics for one rendition of a running [AbrLadder].
+class RenditionStatistics {
+  /// The rendition these statistics belong to.
+  final Rendition rendition;
+
+  /// Number of video packets produced so far.
+  final int frameCount;
+
+  /// Presentation time of the last packet, in seconds.
+  final double time;
+
+  /// Total encoded video payload in bytes.
+  final int size;
+
+  /// Average encoded video bitrate in kbit/s as reported by the encoder.
+  final double averageBitrateKbps;
+
+  /// Creates a new [RenditionStatistics].
+  const RenditionStatistics(
+    this.rendition,
+    this.frameCount,
+    this.time,
+    this.size,
+    this.averageBitrateKbps,
+  );
+
+  /// Returns a string representation of this statistics.
+  @override
+  String toString() =>
+      'RenditionStatistics(${rendition.name}, frames: $frameCount, time: $time, size: $size, abr: $averageBitrateKbps)';
+}
+
+/// Callback invoked with the latest per-rendition statistics.
+typedef AbrStatisticsCallback =
+    void Function(Map<String, RenditionStatistics> statistics);
+
+/// Outcome of [AbrLadder.execute].
+class AbrLadderResult {
+  /// The single session that produced every rendition.
+  final FFmpegSession session;
+
+  /// Final statistics keyed by rendition name.
+  final Map<String, RenditionStatistics> statistics;
+
+  /// Top-level manifest (`master.m3u8` or `manifest.mpd`), or `null` for MP4.
+  final String? manifestPath;
+
+  /// Per-rendition outputs keyed by rendition name (media playlist or file).
+  final Map<String, String> outputs;
+
+  AbrLadderResult._(
+    this.session,
+    this.statistics,
+    this.manifestPath,
+    this.outputs,
+  );
+
+  /// Whether the session completed successfully.
+  bool get isSuccess => ReturnCode.isSuccess(session.getReturnCode());
+}
+
+/// Builds a decode-once, encode-many adaptive bitrate ladder.
+///
+/// The input is decoded a single time and fanned out through a `split`
+/// filter into one `scale` branch per [Rendition], each feeding its own
+/// encoder.  Compared to one session per rendition this removes N-1 decodes
+/// and lets every rung share the same keyframe schedule, so segments stay
+/// aligned across renditions.
+///
+/// Per-rendition statistics are collected from FFmpeg's encoder statistics
+/// (`-stats_enc_post`) and reported through [onStatistics] while the session
+/// runs; the regular session-wide [FFmpegStatisticsCallback] remains
+/// available for overall progress.
+///
+/// ```dart
+/// final result = await AbrLadder(
+///   input: '/path/to/source.mp4',
+///   outputDirectory: '/path/to/out',
+///   renditions: const [
+///     Rendition(name: '1080p', height: 1080, videoBitrateKbps: 5000),
+///     Rendition(name: '720p', height: 720, videoBitrateKbps: 2800),
+///     Rendition(name: '480p', height: 480, videoBitrateKbps: 1400),
+///   ],
+/// ).execute();
+/// print(result.manifestPath);
+/// ```
+class AbrLadder {
+  /// Source media path or URL.
+  final String input;
+
+  /// Directory receiving every output; created if missing.
+  final String outputDirectory;
+
+  /// Renditions, typically ordered from highest to lowest quality.
+  final List<Rendition> renditions;
+
+  /// Output container.
+  final AbrFormat format;
+
+  /// Target segment duration in seconds; keyframes are forced on this grid.
+  final int segmentDuration;
+
+  /// Whether the first audio stream of the input is encoded alongside video.
+  final bool includeAudio;
+
+  /// Receives per-rendition statistics while the session runs.
+  final AbrStatisticsCallback? onStatistics;
+
+  /// Receives session-wide statistics while the session runs.
+  final FFmpegStatisticsCallback? statisticsCallback;
+
+  /// Receives log lines produced by the session.
+  final FFmpegLogCallback? logCallback;
+
+  /// How often encoder statistics files are polled.
+  final Duration statisticsInterval;
+
+  /// Creates a new [AbrLadder].
+  ///
+  /// Throws [ArgumentError] if [renditions] is empty or contains duplicate
+  /// names.
+  AbrLadder({
+    required this.input,
+    required this.outputDirectory,
+    required this.renditions,
+    this.format = AbrFormat.hls,
+    this.segmentDuration = 6,
+    this.includeAudio = true,
+    this.onStatistics,
+    this.statisticsCallback,
+    this.logCallback,
+    this.statisticsInterval = const Duration(milliseconds: 500),
+  }) {
+    if (renditions.isEmpty) {
+      throw ArgumentError.value(renditions, 'renditions', 'must not be empty');
+    }
+    final names = renditions.map((r) => r.name).toSet();
+    if (names.length != renditions.length) {
+      throw ArgumentError.value(
+        renditions,
+        'renditions',
+        'names must be unique',
+      );
+    }
+  }
+
+  /// Path of the top-level manifest, or `null` for [AbrFormat.mp4].
+  String? get manifestPath => switch (format) {
+    AbrFormat.hls => p.join(outputDirectory, 'master.m3u8'),
+    AbrFormat.dash => p.join(outputDirectory, 'manifest.mpd'),
+    AbrFormat.mp4 => null,
+  };
+
+  /// Per-rendition output paths keyed by rendition name.
+  Map<String, String> get outputs => {
+    for (final r in renditions)
+      r.name: switch (format) {
+        AbrFormat.hls => p.join(outputDirectory, r.name, 'index.m3u8'),
+        AbrFormat.dash => p.join(outputDirectory, 'manifest.mpd'),
+        AbrFormat.mp4 => p.join(outputDirectory, '${r.name}.mp4'),
+      },
+  };
+
+  /// Builds the FFmpeg argument list for this ladder.
+  ///
+  /// [statsPaths], when supplied, must hold one path per rendition and enables
+  /// per-rendition encoder statistics.
+  List<String> buildArguments({List<String>? statsPaths}) {
+    final n = renditions.length;
+    final graph = StringBuffer('[0:v]split=$n');
+    for (var i = 0; i < n; i++) {
+      graph.write('[s$i]');
+    }
+    for (var i = 0; i < n; i++) {
+      final r = renditions[i];
+      graph.write(';[s$i]scale=w=${r.width ?? -2}:h=${r.height}[v$i]');
+    }
+
+    final args = <String>['-y', '-i', input, '-filter_complex', '$graph'];
+    final keyframes = 'expr:gte(t,n_forced*$segmentDuration)';
+
+    // Per-stream encoder options; [index] is the stream index within its
+    // output file, or null when each rendition has its own output file.
+    void videoEncoder(Rendition r, int? index, String? statsPath) {
+      final s = index == null ? 'v' : 'v:$index';
+      args.addAll([
+        '-c:$s',
+        r.videoCodec,
+        '-b:$s',
+        '${r.videoBitrateKbps}k',
+        '-maxrate:$s',
+        '${r._maxRate}k',
+        '-bufsize:$s',
+        '${r._maxRate * 2}k',
+        '-force_key_frames:$s',
+        keyframes,
+      ]);
+      r.videoOptions.forEach((key, value) => args.addAll(['-$key:$s', value]));
+      if (statsPath != null) {
+        args.addAll([
+          '-stats_enc_post:$s',
+          statsPath,
+          '-stats_enc_post_fmt:$s',
+          '{n} {t} {size} {abr}',
+        ]);
+      }
+    }
+
+    switch (format) {
+      case AbrFormat.hls:
+        for (var i = 0; i < n; i++) {
+          args.addAll(['-map', '[v$i]']);
+          if (includeAudio) args.addAll(['-map', '0:a:0']);
+        }
+        for (var i = 0; i < n; i++) {
+          videoEncoder(renditions[i], i, statsPaths?[i]);
+          if (includeAudio) {
+            args.addAll([
+              '-c:a:$i',
+              renditions[i].audioCodec,
+              '-b:a:$i',
+              '${renditions[i].audioBitrateKbps}k',
+            ]);
+          }
+        }
+        args.addAll([
+          '-f',
+          'hls',
+          '-hls_time',
+          '$segmentDuration',
+          '-hls_playlist_type',
+          'vod',
+          '-hls_segment_filename',
+          p.join(outputDirectory, '%v', 'segment_%05d.ts'),
+          '-master_pl_name',
+          'master.m3u8',
+          '-var_stream_map',
+          [
+            for (var i = 0; i < n; i++)
+              includeAudio
+                  ? 'v:$i,a:$i,name:${renditions[i].name}'
+                  : 'v:$i,name:${renditions[i].name}',
+          ].join(' '),
+          p.join(outputDirectory, '%v', 'index.m3u8'),
+        ]);
+      case AbrFormat.dash:
+        for (var i = 0; i < n; i++) {
+          args.addAll(['-map', '[v$i]']);
+        }
+        if (includeAudio) args.addAll(['-map', '0:a:0']);
+        for (var i = 0; i < n; i++) {
+          videoEncoder(renditions[i], i, statsPaths?[i]);
+        }
+        if (includeAudio) {
+          // DASH shares one audio adaptation set across every rendition.
+          final audioKbps = renditions
+              .map((r) => r.audioBitrateKbps)
+              .reduce((a, b) => a > b ? a : b);
+          args.addAll([
+            '-c:a',
+            renditions.first.audioCodec,
+            '-b:a',
+            '${audioKbps}k',
+          ]);
+        }
+        args.addAll([
+          '-f',
+          'dash',
+          '-seg_duration',
+          '$segmentDuration',
+          '-adaptation_sets',
+          includeAudio ? 'id=0,streams=v id=1,streams=a' : 'id=0,streams=v',
+          manifestPath!,
+        ]);
+      case AbrFormat.mp4:
+        final files = outputs;
+        for (var i = 0; i < n; i++) {
+          final r = renditions[i];
+          args.addAll(['-map', '[v$i]']);
+          if (includeAudio) args.addAll(['-map', '0:a:0']);
+          videoEncoder(r, null, statsPaths?[i]);
+          if (includeAudio) {
+            args.addAll([
+              '-c:a',
+              r.audioCodec,
+              '-b:a',
+              '${r.audioBitrateKbps}k',
+            ]);
+          }
+          args.addAll(['-movflags', '+faststart', files[r.name]!]);
+        }
+    }
+    return args;
+  }
+
+  /// Runs the ladder in a single [FFmpegSession] and resolves on completion.
+  Future<AbrLadderResult> execute() async {
+    final outDir = Directory(outputDirectory);
+    await outDir.create(recursive: true);
+    if (format == AbrFormat.hls) {
+      for (final r in renditions) {
+        await Directory(p.join(outputDirectory, r.name)).create();
+      }
+    }
+
+    final statsDir = await Directory.systemTemp.createTemp('ffmpeg_kit_abr');
+    final tails = [
+      for (var i = 0; i < renditions.length; i++)
+        _EncoderStatsTail(renditions[i], p.join(statsDir.path, 'enc_$i.log')),
+    ];
+
+    Map<String, RenditionStatistics> poll() {
+      final snapshot = <String, RenditionStatistics>{};
+      for (final tail in tails) {
+        tail.poll();
+        snapshot[tail.rendition.name] = tail.statistics;
+      }
+      return snapshot;
+    }
+
+    final session = FFmpegSession.fromArguments(
+      buildArguments(statsPaths: tails.map((t) => t.path).toList()),
+      logCallback: logCallback,
+      statisticsCallback: statisticsCallback,
+    );
+
+    Timer? timer;
+    if (onStatistics != null) {
+      timer = Timer.periodic(statisticsInterval, (_) {
+        try {
+          onStatistics!(poll());
+        } catch (e, st) {
+          log(
+            'AbrLadder.execute: error in onStatistics callback',
+            error: e,
+            stackTrace: st,
+          );
+        }
+      });
+    }
+
+    try {
+      await session.executeAsync();
+      timer?.cancel();
+      final statistics = poll();
+      onStatistics?.call(statistics);
+      return AbrLadderResult._(session, statistics, manifestPath, outputs);
+    } finally {
+      timer?.cancel();
+      for (final tail in tails) {
+        tail.close();
+      }
+      try {
+        await statsDir.delete(recursive: true);
+      } catch (e, st) {
+        log(
+          'AbrLadder.execute: error deleting statistics directory ${statsDir.path}',
+          error: e,
+          stackTrace: st,
+        );
+      }
+    }
+  }
+}
+
+/// Incrementally reads an `-stats_enc_post` file written with the format
+/// `{n} {t} {size} {abr}`.
+class _EncoderStatsTail {
+  final Rendition rendition;
+  final String path;
+
+  RandomAccessFile? _file;
+  String _partial = '';
+  int _frames = 0;
+  double _time = 0;
+  int _size = 0;
+  double _abr = 0;
+
+  _EncoderStatsTail(this.rendition, this.path);
+
+  RenditionStatistics get statistics =>
+      RenditionStatistics(rendition, _frames, _time, _size, _abr);
+
+  void poll() {
+    try {
+      _file ??= File(path).existsSync()
+          ? File(path).openSync(mode: FileMode.read)
+          : null;
+      final file = _file;
+      if (file == null) return;
+      final available = file.lengthSync() - file.positionSync();
+      if (available <= 0) return;
+      final chunk = _partial + utf8.decode(file.readSync(available));
+      final lines = chunk.split('\n');
+      _partial = lines.removeLast();
+      for (final line in lines) {
+        final fields = line.trim().split(' ');
+        if (fields.length < 4) continue;
+        final n = int.tryParse(fields[0]);
+        if (n != null) _frames = n + 1;
+        _time = double.tryParse(fields[1]) ?? _time;
+        _size += int.tryParse(fields[2]) ?? 0;
+        _abr = double.tryParse(fields[3]) ?? _abr;
+      }
+    } catch (e, st) {
+      log(
+        'AbrLadder: error reading encoder statistics $path',
+        error: e,
+        stackTrace: st,
+      );
+    }
+  }
+
+  void close() {
+    try {
+      _file?.closeSync();
+    } catch (_) {}
+    _file = null;
+  }
+}
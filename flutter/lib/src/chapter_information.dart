@@ -17,6 +17,7 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
  */
 
+import 'dart:collection';
 import 'dart:convert';
 
 /// Represents a chapter within a media file.
@@ -46,24 +47,16 @@ class ChapterInformation {
   final String? allPropertiesJson;
 
   /// Parsed map of tags from keys to values.
-  Map<String, dynamic>? get tags {
-    if (tagsJson == null || tagsJson!.isEmpty) return null;
-    try {
-      return jsonDecode(tagsJson!);
-    } catch (_) {
-      return null;
-    }
-  }
+  ///
+  /// Only [tagsJson] is retained; it is decoded on first access into a
+  /// read-only map.
+  late final Map<String, dynamic>? tags = _decodeObject(tagsJson);
 
   /// Parsed map of all properties from keys to values.
-  Map<String, dynamic>? get allProperties {
-    if (allPropertiesJson == null || allPropertiesJson!.isEmpty) return null;
-    try {
-      return jsonDecode(allPropertiesJson!);
-    } catch (_) {
-      return null;
-    }
-  }
+  ///
+  /// Decoded from [allPropertiesJson] on first access, like [tags].
+  late final Map<String, dynamic>? allProperties =
+      _decodeObject(allPropertiesJson);
 
   /// Creates a new [ChapterInformation] instance with the given metadata.
   ChapterInformation({
@@ -77,7 +70,57 @@ class ChapterInformation {
     this.allPropertiesJson,
   });
 
+  /// Creates a [ChapterInformation] from a map produced by [toJson].
+  factory ChapterInformation.fromJson(Map<String, dynamic> json) =>
+      ChapterInformation(
+        id: json['id'] as int?,
+        timeBase: json['timeBase'] as String?,
+        start: json['start'] as int?,
+        startTime: json['startTime'] as String?,
+        end: json['end'] as int?,
+        endTime: json['endTime'] as String?,
+        tagsJson: json['tagsJson'] as String?,
+        allPropertiesJson: json['allPropertiesJson'] as String?,
+      );
+
+  /// Creates a [ChapterInformation] from one entry of ffprobe's JSON
+  /// `chapters` array.
+  factory ChapterInformation.fromFFprobeJson(Map<String, dynamic> json) {
+    final tags = json['tags'];
+    return ChapterInformation(
+      id: json['id'] as int?,
+      timeBase: json['time_base'] as String?,
+      start: json['start'] as int?,
+      startTime: json['start_time'] as String?,
+      end: json['end'] as int?,
+      endTime: json['end_time'] as String?,
+      tagsJson: tags == null ? null : jsonEncode(tags),
+      allPropertiesJson: jsonEncode(json),
+    );
+  }
+
   @override
   String toString() =>
       'ChapterInformation(id: $id, start: $startTime, end: $endTime)';
+
+  /// Converts this chapter information to a JSON map.
+  Map<String, dynamic> toJson() => {
+    'id': id,
+    'timeBase': timeBase,
+    'start': start,
+    'startTime': startTime,
+    'end': end,
+    'endTime': endTime,
+    'tagsJson': tagsJson,
+    'allPropertiesJson': allPropertiesJson,
+  };
+
+  static Map<String, dynamic>? _decodeObject(String? json) {
+    if (json == null || json.isEmpty) return null;
+    try {
+      return UnmodifiableMapView(jsonDecode(json) as Map<String, dynamic>);
+    } catch (_) {
+      return null;
+    }
+  }
 }
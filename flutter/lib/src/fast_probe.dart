@@ -0,0 +1,368 @@
+/*
+ * FFmpegKit Flutter Extended Plugin - A wrapper library for FFmpeg
+ * Copyright (C) 2026 Akash Patel
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+import 'dart:developer';
+import 'dart:ffi';
+import 'dart:isolate';
+
+import 'package:ffi/ffi.dart';
+
+import 'ffmpeg_kit_extended.dart';
+import 'generated/ffmpeg_kit_bindings.dart' as ffmpeg;
+
+/// Fields that [FastProbe] can extract.
+enum ProbeField {
+  /// Container duration in seconds.
+  duration,
+
+  /// Container format name and overall bitrate.
+  format,
+
+  /// Stream index and type.
+  streams,
+
+  /// Stream codec names; implies [streams].
+  codecs,
+
+  /// Video width and height; implies [streams].
+  dimensions,
+
+  /// Container and stream tags.
+  tags,
+}
+
+/// A stream reported by [FastProbe].
+class ProbeStream {
+  /// Stream index within the container.
+  final int index;
+
+  /// Stream type (`video`, `audio`, `subtitle`, `data`, ...).
+  final String? type;
+
+  /// Codec short name, if [ProbeField.codecs] was requested.
+  final String? codec;
+
+  /// Video width in pixels, if [ProbeField.dimensions] was requested.
+  final int? width;
+
+  /// Video height in pixels, if [ProbeField.dimensions] was requested.
+  final int? height;
+
+  /// Stream tags, if [ProbeField.tags] was requested.
+  final Map<String, String> tags;
+
+  const ProbeStream({
+    required this.index,
+    this.type,
+    this.codec,
+    this.width,
+    this.height,
+    this.tags = const {},
+  });
+
+  @override
+  String toString() =>
+      'ProbeStream($index, type: $type, codec: $codec, ${width}x$height)';
+}
+
+/// Flat result of a [FastProbe] call.
+///
+/// Fields that were not requested are `null` (or empty).
+class ProbeResult {
+  /// The probed path or URL.
+  final String path;
+
+  /// Container duration in seconds.
+  final double? duration;
+
+  /// Container format name (e.g. `mov,mp4,m4a,3gp,3g2,mj2`).
+  final String? formatName;
+
+  /// Overall bitrate in bits per second.
+  final int? bitrate;
+
+  /// Streams in container order.
+  final List<ProbeStream> streams;
+
+  /// Container tags.
+  final Map<String, String> tags;
+
+  const ProbeResult({
+    required this.path,
+    this.duration,
+    this.formatName,
+    this.bitrate,
+    this.streams = const [],
+    this.tags = const {},
+  });
+
+  /// The first video stream, if any.
+  ProbeStream? get videoStream {
+    for (final stream in streams) {
+      if (stream.type == 'video') return stream;
+    }
+    return null;
+  }
+
+  @override
+  String toString() =>
+      'ProbeResult($path, duration: $duration, streams: ${streams.length})';
+}
+
+/// Exception thrown when [FastProbe] cannot open or read an input.
+class ProbeException implements Exception {
+  /// The probed path or URL.
+  final String path;
+
+  /// The FFprobe return code.
+  final int returnCode;
+
+  /// FFprobe's error output, if any.
+  final String message;
+
+  ProbeException(this.path, this.returnCode, this.message);
+
+  /// Returns a string representation of this exception.
+  @override
+  String toString() => 'ProbeException($path, $returnCode): $message';
+}
+
+/// Lightweight probe that extracts only the requested fields.
+///
+/// A [MediaInformationSession] runs a full ffprobe with every section enabled,
+/// registers callbacks, captures logs, produces JSON, and then walks it through
+/// dozens of FFI getters.  [FastProbe] instead asks ffprobe for just the
+/// requested entries (`-show_entries`) in its compact line format, honours
+/// caller-set `probesize`/`analyzeduration` limits, and runs the native call on
+/// a background isolate without a Dart session object, callback registration,
+/// or queueing behind transcodes.  The native library still creates a session
+/// for each probe, which keeps its own log, and [executeSync] releases it as
+/// soon as the output is read.
+class FastProbe {
+  FastProbe._();
+
+  /// Default set of fields returned by [probe].
+  static const Set<ProbeField> defaultFields = {
+    ProbeField.duration,
+    ProbeField.streams,
+    ProbeField.codecs,
+    ProbeField.dimensions,
+  };
+
+  /// Probes [path] and returns the requested [fields].
+  ///
+  /// [probeSize] (bytes) and [analyzeDuration] bound how much of the input is
+  /// read while detecting streams; small values make probing faster at the
+  /// cost of accuracy for exotic inputs.
+  ///
+  /// Throws [ProbeException] if the input cannot be opened.
+  static Future<ProbeResult> probe(
+    String path, {
+    Set<ProbeField> fields = defaultFields,
+    int? probeSize,
+    Duration? analyzeDuration,
+  }) async {
+    FFmpegKitExtended.requireInitialized();
+    final arguments = buildArguments(
+      path,
+      fields: fields,
+      probeSize: probeSize,
+      analyzeDuration: analyzeDuration,
+    );
+    final (returnCode, output) = await Isolate.run(
+      () => executeSync(arguments),
+      debugName: 'FastProbe',
+    );
+    if (returnCode != 0) {
+      throw ProbeException(path, returnCode, output.trim());
+    }
+    return parseOutput(path, output);
+  }
+
+  /// Builds the ffprobe arguments used by [probe].
+  static List<String> buildArguments(
+    String path, {
+    Set<ProbeField> fields = defaultFields,
+    int? probeSize,
+    Duration? analyzeDuration,
+  }) {
+    final format = <String>[
+      if (fields.contains(ProbeField.duration)) 'duration',
+      if (fields.contains(ProbeField.format)) ...['format_name', 'bit_rate'],
+    ];
+    final wantsStreams =
+        fields.contains(ProbeField.streams) ||
+        fields.contains(ProbeField.codecs) ||
+        fields.contains(ProbeField.dimensions);
+    final stream = <String>[
+      if (wantsStreams) ...['index', 'codec_type'],
+      if (fields.contains(ProbeField.codecs)) 'codec_name',
+      if (fields.contains(ProbeField.dimensions)) ...['width', 'height'],
+    ];
+    final sections = <String>[
+      if (format.isNotEmpty) 'format=${format.join(',')}',
+      if (stream.isNotEmpty) 'stream=${stream.join(',')}',
+      if (fields.contains(ProbeField.tags)) 'format_tags',
+      if (fields.contains(ProbeField.tags) && wantsStreams) 'stream_tags',
+    ];
+    return [
+      '-v',
+      'error',
+      '-hide_banner',
+      if (probeSize != null) ...['-probesize', '$probeSize'],
+      if (analyzeDuration != null) ...[
+        '-analyzeduration',
+        '${analyzeDuration.inMicroseconds}',
+      ],
+      '-show_entries',
+      sections.join(':'),
+      '-of',
+      'compact=p=1:nk=0',
+      path,
+    ];
+  }
+
+  /// Runs ffprobe with [arguments] on the calling thread.
+  ///
+  /// Returns the return code and captured output.  Intended for background
+  /// isolates; [probe] calls it through [Isolate.run].
+  static (int, String) executeSync(List<String> arguments) {
+    final argv = calloc<Pointer<Char>>(arguments.length);
+    final strings = <Pointer<Utf8>>[];
+    Pointer<Void> handle = nullptr;
+    try {
+      for (var i = 0; i < arguments.length; i++) {
+        final s = arguments[i].toNativeUtf8(allocator: calloc);
+        strings.add(s);
+        argv[i] = s.cast();
+      }
+      handle = ffmpeg.ffprobe_kit_create_session_from_argv(
+        arguments.length,
+        argv,
+      );
+      if (handle == nullptr) {
+        throw StateError('Failed to create FFprobe session from arguments.');
+      }
+      ffmpeg.ffprobe_kit_session_execute(handle);
+      final returnCode = ffmpeg.ffmpeg_kit_session_get_return_code(handle);
+      final outputPtr = ffmpeg.ffmpeg_kit_session_get_output(handle);
+      var output = '';
+      if (outputPtr != nullptr) {
+        output = outputPtr.cast<Utf8>().toDartString();
+        ffmpeg.ffmpeg_kit_free(outputPtr.cast());
+      }
+      return (returnCode, output);
+    } catch (e, st) {
+      log(
+        'FastProbe.executeSync: error executing ffprobe_kit_session_execute',
+        error: e,
+        stackTrace: st,
+      );
+      rethrow;
+    } finally {
+      if (handle != nullptr) ffmpeg.ffmpeg_kit_handle_release(handle);
+      for (final s in strings) {
+        calloc.free(s);
+      }
+      calloc.free(argv);
+    }
+  }
+
+  /// Parses ffprobe `compact` output into a [ProbeResult].
+  static ProbeResult parseOutput(String path, String output) {
+    double? duration;
+    String? formatName;
+    int? bitrate;
+    final streams = <ProbeStream>[];
+    final tags = <String, String>{};
+
+    for (final line in output.split('\n')) {
+      final items = _splitCompact(line.trimRight());
+      if (items.isEmpty) continue;
+      final values = <String, String>{};
+      final itemTags = <String, String>{};
+      for (final item in items.skip(1)) {
+        final eq = item.indexOf('=');
+        if (eq <= 0) continue;
+        final key = item.substring(0, eq);
+        final value = item.substring(eq + 1);
+        if (key.startsWith('tag:')) {
+          itemTags[key.substring(4)] = value;
+        } else {
+          values[key] = value;
+        }
+      }
+      switch (items.first) {
+        case 'format':
+          duration = double.tryParse(values['duration'] ?? '');
+          formatName = values['format_name'];
+          bitrate = int.tryParse(values['bit_rate'] ?? '');
+          tags.addAll(itemTags);
+        case 'stream':
+          streams.add(
+            ProbeStream(
+              index: int.tryParse(values['index'] ?? '') ?? streams.length,
+              type: values['codec_type'],
+              codec: values['codec_name'],
+              width: int.tryParse(values['width'] ?? ''),
+              height: int.tryParse(values['height'] ?? ''),
+              tags: itemTags,
+            ),
+          );
+      }
+    }
+    return ProbeResult(
+      path: path,
+      duration: duration,
+      formatName: formatName,
+      bitrate: bitrate,
+      streams: streams,
+      tags: tags,
+    );
+  }
+
+  /// Splits a compact-writer line on unescaped `|` and unescapes each item.
+  static List<String> _splitCompact(String line) {
+    if (line.isEmpty) return const [];
+    final items = <String>[];
+    final current = StringBuffer();
+    for (var i = 0; i < line.length; i++) {
+      final c = line[i];
+      if (c == r'\' && i + 1 < line.length) {
+        // The compact writer uses C escapes for control characters.
+        final next = line[++i];
+        current.write(switch (next) {
+          'n' => '\n',
+          'r' => '\r',
+          't' => '\t',
+          'b' => '\b',
+          'f' => '\f',
+          _ => next,
+        });
+      } else if (c == '|') {
+        items.add(current.toString());
+        current.clear();
+      } else {
+        current.write(c);
+      }
+    }
+    items.add(current.toString());
+    return items;
+  }
+}
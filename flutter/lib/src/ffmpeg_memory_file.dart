@@ -0,0 +1,302 @@
+/*
+ * FFmpegKit Flutter Extended Plugin - A wrapper library for FFmpeg
+ * Copyright (C) 2026 Akash Patel
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+import 'dart:developer';
+import 'dart:ffi';
+import 'dart:io';
+import 'dart:math' as math;
+import 'dart:typed_data';
+
+import 'package:ffi/ffi.dart';
+import 'package:path/path.dart' as p;
+
+import 'ffmpeg_session.dart';
+import 'libc.dart';
+import 'session.dart';
+
+/// An anonymous, seekable, in-memory file that FFmpeg opens through `fd:`.
+///
+/// On Linux and Android the file is a `memfd`; on macOS and iOS (and on
+/// Android versions without `memfd_create`) it is a temporary file that is
+/// unlinked immediately after creation, so it never has a visible path and
+/// its pages normally stay in the page cache.  FFmpeg reads and writes it
+/// through its `fd` protocol, which supports seeking, so inputs with a
+/// trailing index and outputs that seek back to patch their headers (such as
+/// plain MP4) work.
+///
+/// Outputs cannot be reopened, however: the MP4 `+faststart` pass opens the
+/// output URL a second time without the `-fd` option, which makes `fd:`
+/// fall back to standard input.  Use a regular file for faststart outputs.
+///
+/// Bytes can be written from native buffers with [writeFrom] without an
+/// intermediate Dart copy.  Close the file with [close] when done; the
+/// descriptor is otherwise closed when the object is garbage collected.
+///
+/// Not available on Windows, see [isSupported].
+class FFmpegMemoryFile {
+  /// The underlying file descriptor.
+  final int fd;
+
+  bool _closed = false;
+
+  static final Finalizer<int> _finalizer = Finalizer(
+    (fd) => LibC.instance.close(fd),
+  );
+
+  FFmpegMemoryFile._(this.fd) {
+    _finalizer.attach(this, fd, detach: this);
+  }
+
+  /// Whether in-memory files are available on this platform.
+  static bool get isSupported =>
+      Platform.isLinux ||
+      Platform.isAndroid ||
+      Platform.isMacOS ||
+      Platform.isIOS;
+
+  /// Creates an empty in-memory file.
+  ///
+  /// Throws [UnsupportedError] if [isSupported] is `false`, or
+  /// [FileSystemException] if the descriptor cannot be created.
+  factory FFmpegMemoryFile.create({String name = 'ffmpegkit'}) {
+    if (!isSupported) {
+      throw UnsupportedError('In-memory files are not supported on this OS');
+    }
+    return FFmpegMemoryFile._(LibC.instance.createAnonymous(name));
+  }
+
+  /// Creates an in-memory file holding [bytes].
+  factory FFmpegMemoryFile.fromBytes(
+    Uint8List bytes, {
+    String name = 'ffmpegkit',
+  }) => FFmpegMemoryFile.create(name: name)..write(bytes);
+
+  /// Arguments that open this file as an FFmpeg input.
+  ///
+  /// The `fd` protocol takes the descriptor as an option rather than in the
+  /// URL, hence the `-fd` before `-i fd:`.
+  List<String> get inputArguments => ['-fd', '$fd', '-i', 'fd:'];
+
+  /// Arguments that select this file as an FFmpeg output muxed as [format].
+  ///
+  /// The format must be explicit, because it cannot be guessed from the URL.
+  /// Muxer options that reopen the output, such as `-movflags +faststart`,
+  /// do not work with `fd:`.
+  List<String> outputArguments(String format) => [
+    '-fd',
+    '$fd',
+    '-f',
+    format,
+    'fd:',
+  ];
+
+  /// Current size of the file in bytes.
+  int get length {
+    _checkOpen();
+    final libc = LibC.instance;
+    final position = libc.seek(fd, 0, LibC.seekCur);
+    final end = libc.seek(fd, 0, LibC.seekEnd);
+    libc.seek(fd, position, LibC.seekSet);
+    return end;
+  }
+
+  /// Appends [bytes] at the current position.
+  void write(Uint8List bytes) {
+    _checkOpen();
+    const chunk = 1 << 20;
+    final buffer = malloc<Uint8>(math.min(bytes.length, chunk));
+    try {
+      for (var offset = 0; offset < bytes.length; offset += chunk) {
+        final n = math.min(chunk, bytes.length - offset);
+        buffer.asTypedList(n).setRange(0, n, bytes, offset);
+        writeFrom(buffer, n);
+      }
+    } finally {
+      malloc.free(buffer);
+    }
+  }
+
+  /// Appends [length] bytes from the native buffer [data] at the current
+  /// position, without copying them through Dart.
+  void writeFrom(Pointer<Uint8> data, int length) {
+    _checkOpen();
+    final libc = LibC.instance;
+    var written = 0;
+    while (written < length) {
+      final n = libc.write(fd, data + written, length - written);
+      if (n < 0) {
+        throw FileSystemException(
+          'write failed (errno ${libc.errno})',
+          'fd:$fd',
+        );
+      }
+      written += n;
+    }
+  }
+
+  /// Moves the position back to the start.  FFmpeg duplicates the
+  /// descriptor and so shares its position; call before each session that
+  /// reads this file.
+  void rewind() {
+    _checkOpen();
+    LibC.instance.seek(fd, 0, LibC.seekSet);
+  }
+
+  /// Truncates the file to zero length, e.g. before reusing it as an output.
+  void clear() {
+    _checkOpen();
+    rewind();
+    LibC.instance.truncate(fd, 0);
+  }
+
+  /// Reads the whole file into a new buffer.
+  Uint8List readAsBytes() {
+    final size = length;
+    final libc = LibC.instance;
+    final result = Uint8List(size);
+    if (size == 0) return result;
+    final buffer = malloc<Uint8>(size);
+    try {
+      var read = 0;
+      while (read < size) {
+        final n = libc.pread(fd, buffer + read, size - read, read);
+        if (n <= 0) {
+          throw FileSystemException(
+            'read failed (errno ${libc.errno})',
+            'fd:$fd',
+          );
+        }
+        read += n;
+      }
+      result.setAll(0, buffer.asTypedList(size));
+    } finally {
+      malloc.free(buffer);
+    }
+    return result;
+  }
+
+  /// Closes the descriptor, releasing the memory.
+  void close() {
+    if (_closed) return;
+    _closed = true;
+    _finalizer.detach(this);
+    LibC.instance.close(fd);
+  }
+
+  void _checkOpen() {
+    if (_closed) throw StateError('FFmpegMemoryFile $fd is closed');
+  }
+
+  /// Runs FFmpeg on [input] held in memory and returns the output muxed as
+  /// [format].
+  ///
+  /// [inputOptions] and [outputOptions] go before the input and output
+  /// respectively.  On platforms without in-memory files, private temporary
+  /// files are used instead.  `output` is `null` when the session fails.
+  ///
+  /// Throws [ArgumentError] if [outputOptions] request `+faststart`, which
+  /// cannot write to an in-memory output.
+  ///
+  /// ```dart
+  /// final (:session, :output) = await FFmpegMemoryFile.transcode(
+  ///   upload,
+  ///   format: 'mp4',
+  ///   outputOptions: ['-vf', 'scale=720:-2'],
+  /// );
+  /// ```
+  static Future<({FFmpegSession session, Uint8List? output})> transcode(
+    Uint8List input, {
+    required String format,
+    List<String> inputOptions = const [],
+    List<String> outputOptions = const [],
+  }) async {
+    for (var i = 0; i + 1 < outputOptions.length; i++) {
+      if (outputOptions[i] == '-movflags' &&
+          outputOptions[i + 1].contains('faststart')) {
+        throw ArgumentError.value(
+          outputOptions[i + 1],
+          'outputOptions',
+          'faststart reopens the output, which fd: does not support',
+        );
+      }
+    }
+    if (!isSupported) {
+      return _transcodeWithFiles(input, format, inputOptions, outputOptions);
+    }
+
+    final source = FFmpegMemoryFile.fromBytes(input, name: 'ffmpegkit-in');
+    final sink = FFmpegMemoryFile.create(name: 'ffmpegkit-out');
+    try {
+      source.rewind();
+      final session = await FFmpegSession.fromArguments([
+        ...inputOptions,
+        ...source.inputArguments,
+        ...outputOptions,
+        ...sink.outputArguments(format),
+      ]).executeAsync();
+      final success = ReturnCode.isSuccess(session.getReturnCode());
+      return (session: session, output: success ? sink.readAsBytes() : null);
+    } catch (e, st) {
+      log(
+        'FFmpegMemoryFile.transcode: error transcoding from memory',
+        error: e,
+        stackTrace: st,
+      );
+      rethrow;
+    } finally {
+      source.close();
+      sink.close();
+    }
+  }
+
+  static Future<({FFmpegSession session, Uint8List? output})>
+  _transcodeWithFiles(
+    Uint8List input,
+    String format,
+    List<String> inputOptions,
+    List<String> outputOptions,
+  ) async {
+    final scratch = await Directory.systemTemp.createTemp('ffmpeg_kit_mem');
+    try {
+      final source = File(p.join(scratch.path, 'input'));
+      final sink = File(p.join(scratch.path, 'output'));
+      await source.writeAsBytes(input);
+      final session = await FFmpegSession.fromArguments([
+        ...inputOptions,
+        '-i',
+        source.path,
+        ...outputOptions,
+        '-f',
+        format,
+        '-y',
+        sink.path,
+      ]).executeAsync();
+      final success =
+          ReturnCode.isSuccess(session.getReturnCode()) && await sink.exists();
+      return (
+        session: session,
+        output: success ? await sink.readAsBytes() : null,
+      );
+    } finally {
+      try {
+        await scratch.delete(recursive: true);
+      } catch (_) {}
+    }
+  }
+}
@@ -0,0 +1,337 @@
+/*
+ * FFmpegKit Flutter Extended Plugin - A wrapper library for FFmpeg
+ * Copyright (C) 2026 Akash Patel
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+import 'dart:async';
+import 'dart:developer';
+import 'dart:io';
+import 'dart:typed_data';
+
+import 'ffmpeg_kit_extended.dart';
+import 'ffmpeg_session.dart';
+
+/// Feeds a Dart byte stream into FFmpeg through a registered FFmpeg pipe.
+///
+/// Use [path] as an input in the command and pass the source to
+/// [FFmpegPipes.executeAsync].  Incoming chunks are coalesced into writes of
+/// up to [batchSize] bytes which run on dart:io's I/O threads, so the calling
+/// isolate never blocks on the pipe.  The source is paused while a write is
+/// in flight, which bounds buffering to one batch and lets a full pipe slow
+/// the producer down.  A partial batch is written after [flushDelay] without
+/// new data so that live sources keep a low latency.
+class FFmpegPipeInput {
+  /// Path of the pipe, to be used as an FFmpeg input.
+  final String path;
+
+  /// Size at which buffered chunks are written to the pipe.
+  final int batchSize;
+
+  /// How long a partial batch may wait for more data before being written.
+  final Duration flushDelay;
+
+  RandomAccessFile? _file;
+  bool _opening = false;
+  bool _released = false;
+  void Function()? _stop;
+
+  /// Registers a new FFmpeg pipe for writing.
+  ///
+  /// Throws [StateError] if the pipe cannot be created.
+  FFmpegPipeInput({
+    this.batchSize = 64 * 1024,
+    this.flushDelay = const Duration(milliseconds: 5),
+  }) : path = _registerPipe();
+
+  /// Writes [source] to the pipe and closes it when [source] is done.
+  ///
+  /// Completes normally if FFmpeg stops reading early (for example because of
+  /// `-t` or `-frames`), and with the source's error if [source] fails.
+  Future<void> addStream(Stream<List<int>> source) async {
+    if (_opening || _file != null) {
+      throw StateError('A stream was already added to $path');
+    }
+    _opening = true;
+    final RandomAccessFile file;
+    try {
+      file = _file = await File(path).open(mode: FileMode.writeOnly);
+    } finally {
+      _opening = false;
+    }
+    if (_released) {
+      await file.close();
+      return;
+    }
+
+    final buffer = BytesBuilder();
+    final finished = Completer<void>();
+    Future<void> inFlight = Future.value();
+    Timer? idle;
+    late final StreamSubscription<List<int>> subscription;
+
+    void finish([Object? error, StackTrace? stackTrace]) {
+      idle?.cancel();
+      _stop = null;
+      if (finished.isCompleted) return;
+      if (error == null) {
+        finished.complete();
+      } else {
+        finished.completeError(error, stackTrace);
+      }
+    }
+
+    void onWriteError(Object error, StackTrace stackTrace) {
+      subscription.cancel();
+      // The read end was closed: FFmpeg needs no more input.
+      finish(error is FileSystemException ? null : error, stackTrace);
+    }
+
+    Future<void> flush() async {
+      idle?.cancel();
+      idle = null;
+      if (buffer.isEmpty) return;
+      subscription.pause();
+      try {
+        final write = file.writeFrom(buffer.takeBytes());
+        inFlight = write.then((_) {}, onError: (_) {});
+        await write;
+      } finally {
+        subscription.resume();
+      }
+    }
+
+    subscription = source.listen(
+      (chunk) {
+        buffer.add(chunk);
+        if (buffer.length >= batchSize) {
+          flush().catchError(onWriteError);
+        } else {
+          idle ??= Timer(
+            flushDelay,
+            () => flush().catchError(onWriteError),
+          );
+        }
+      },
+      onError: (Object e, StackTrace st) {
+        subscription.cancel();
+        finish(e, st);
+      },
+      onDone: () => flush().then((_) => finish(), onError: onWriteError),
+      cancelOnError: true,
+    );
+    _stop = () {
+      subscription.cancel();
+      finish();
+    };
+
+    try {
+      await finished.future;
+    } finally {
+      _file = null;
+      await inFlight;
+      try {
+        await file.close();
+      } on FileSystemException catch (_) {}
+    }
+  }
+
+  /// Stops writing and unregisters the pipe once the session has finished.
+  Future<void> _release() async {
+    _released = true;
+    _stop?.call();
+    if (_opening) {
+      // FFmpeg exited without opening the pipe; pair the pending open with a
+      // reader so that it does not block forever.
+      try {
+        await (await File(path).open()).close();
+      } on FileSystemException catch (_) {}
+    }
+    FFmpegKitExtended.closeFFmpegPipe(path);
+  }
+}
+
+/// Streams FFmpeg output written to a registered FFmpeg pipe into Dart.
+///
+/// Use [path] as an output in the command (with an explicit `-f`, since the
+/// muxer cannot be guessed from the pipe name) and listen to [stream] before
+/// starting the session: FFmpeg blocks when it opens the pipe until a reader
+/// is attached.  Reads of up to [chunkSize] bytes run on dart:io's I/O
+/// threads and stop while the subscription is paused, so a slow consumer
+/// throttles FFmpeg through the pipe instead of buffering without bound.
+class FFmpegPipeOutput {
+  /// Path of the pipe, to be used as an FFmpeg output.
+  final String path;
+
+  /// Maximum size of each emitted chunk.
+  final int chunkSize;
+
+  late final StreamController<Uint8List> _controller =
+      StreamController<Uint8List>(
+        onListen: _pump,
+        onResume: _pump,
+        onCancel: _cancel,
+      );
+  RandomAccessFile? _file;
+  bool _opening = false;
+  bool _pumping = false;
+  bool _released = false;
+
+  /// Registers a new FFmpeg pipe for reading.
+  ///
+  /// Throws [StateError] if the pipe cannot be created.
+  FFmpegPipeOutput({this.chunkSize = 64 * 1024}) : path = _registerPipe();
+
+  /// The bytes FFmpeg writes to [path]; done when FFmpeg closes the pipe.
+  Stream<Uint8List> get stream => _controller.stream;
+
+  Future<void> _pump() async {
+    if (_pumping || _controller.isClosed) return;
+    _pumping = true;
+    try {
+      var file = _file;
+      if (file == null) {
+        _opening = true;
+        try {
+          file = _file = await File(path).open();
+        } finally {
+          _opening = false;
+        }
+      }
+      var endOfFile = false;
+      while (_controller.hasListener && !_controller.isPaused) {
+        final chunk = await file.read(chunkSize);
+        if (chunk.isEmpty) {
+          endOfFile = true;
+          break;
+        }
+        _controller.add(chunk);
+      }
+      // End-of-file, or the listener cancelled while a read was in flight.
+      if (endOfFile || !_controller.hasListener) await _finish();
+    } catch (e, st) {
+      if (!_controller.isClosed) _controller.addError(e, st);
+      await _finish();
+    } finally {
+      _pumping = false;
+    }
+  }
+
+  Future<void> _cancel() async {
+    // A running pump notices the cancellation after its current read.
+    if (!_pumping) await _finish();
+  }
+
+  Future<void> _finish() async {
+    final file = _file;
+    _file = null;
+    if (file != null) {
+      try {
+        await file.close();
+      } on FileSystemException catch (_) {}
+    }
+    if (!_controller.isClosed) unawaited(_controller.close());
+    if (_released) FFmpegKitExtended.closeFFmpegPipe(path);
+  }
+
+  /// Unregisters the pipe once the session has finished.
+  Future<void> _release() async {
+    _released = true;
+    if (_opening) {
+      // FFmpeg exited without opening the pipe; give the pending open a
+      // writer so that the reader sees end-of-file.
+      try {
+        await (await File(path).open(mode: FileMode.writeOnly)).close();
+      } on FileSystemException catch (_) {}
+    } else if (_file == null) {
+      // Nothing is reading: never listened to, or already at end-of-file.
+      if (!_controller.hasListener) unawaited(_controller.close());
+      FFmpegKitExtended.closeFFmpegPipe(path);
+    }
+  }
+}
+
+/// Runs FFmpeg sessions bound to [FFmpegPipeInput]s and [FFmpegPipeOutput]s.
+///
+/// ```dart
+/// final input = FFmpegPipeInput();
+/// final output = FFmpegPipeOutput();
+/// output.stream.listen(socket.add);
+/// final session = await FFmpegPipes.executeAsync(
+///   FFmpegSession.fromArguments([
+///     '-f', 'h264', '-i', input.path,
+///     '-c', 'copy', '-f', 'mpegts', output.path,
+///   ]),
+///   inputs: {input: camera.byteStream},
+///   outputs: [output],
+/// );
+/// ```
+class FFmpegPipes {
+  FFmpegPipes._();
+
+  /// Executes [session] while writing each source in [inputs] to its pipe.
+  ///
+  /// When a source fails, [session] is cancelled and the returned future
+  /// completes with the source's error.  When [session] finishes, writers
+  /// stop, readers see end-of-file, and every pipe is unregistered.
+  static Future<FFmpegSession> executeAsync(
+    FFmpegSession session, {
+    Map<FFmpegPipeInput, Stream<List<int>>> inputs = const {},
+    List<FFmpegPipeOutput> outputs = const [],
+  }) async {
+    Object? sourceError;
+    StackTrace? sourceStackTrace;
+    final writers = [
+      for (final MapEntry(key: pipe, value: source) in inputs.entries)
+        pipe.addStream(source).catchError((Object e, StackTrace st) {
+          sourceError ??= e;
+          sourceStackTrace ??= st;
+          session.cancel();
+        }),
+    ];
+
+    try {
+      await session.executeAsync();
+    } catch (e, st) {
+      if (sourceError == null) {
+        log(
+          'FFmpegPipes.executeAsync: error executing session',
+          error: e,
+          stackTrace: st,
+        );
+        rethrow;
+      }
+    } finally {
+      for (final pipe in inputs.keys) {
+        await pipe._release();
+      }
+      for (final pipe in outputs) {
+        await pipe._release();
+      }
+      await Future.wait(writers);
+    }
+
+    final error = sourceError;
+    if (error != null) Error.throwWithStackTrace(error, sourceStackTrace!);
+    return session;
+  }
+}
+
+String _registerPipe() {
+  final path = FFmpegKitExtended.registerNewFFmpegPipe();
+  if (path == null) throw StateError('Failed to register an FFmpeg pipe');
+  return path;
+}
@@ -0,0 +1,450 @@
+/*
+ * FFmpegKit Flutter Extended Plugin - A wrapper library for FFmpeg
+ * Copyright (C) 2026 Akash Patel
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+import 'dart:async';
+import 'dart:collection';
+import 'dart:convert';
+import 'dart:developer';
+import 'dart:io';
+
+import 'package:meta/meta.dart';
+
+import 'callback_manager.dart';
+import 'log.dart';
+import 'session.dart';
+import 'session_queue_manager.dart';
+import 'statistics.dart';
+
+/// Result of a job executed by an [FFmpegProcessPool].
+class FFmpegProcessResult {
+  /// Pool-local job identifier.  Negative so it never collides with native
+  /// session identifiers in shared log or statistics handlers.
+  final int jobId;
+
+  /// Arguments passed to FFmpeg, excluding the ones added by the pool.
+  final List<String> arguments;
+
+  /// Process exit code.  On POSIX systems a negative value is the signal that
+  /// terminated the worker (e.g. `-11` for a segmentation fault).
+  final int returnCode;
+
+  /// Every log line the worker wrote to stderr.
+  final List<Log> logs;
+
+  /// The last statistics block reported by the worker, if any.
+  final Statistics? lastStatistics;
+
+  /// Wall-clock time from process start to exit.
+  final Duration duration;
+
+  /// Whether the job was cancelled through [FFmpegProcessJob.cancel].
+  final bool cancelled;
+
+  FFmpegProcessResult._(
+    this.jobId,
+    this.arguments,
+    this.returnCode,
+    this.logs,
+    this.lastStatistics,
+    this.duration,
+    this.cancelled,
+  );
+
+  /// Whether FFmpeg exited successfully.
+  bool get isSuccess => ReturnCode.isSuccess(returnCode) && !cancelled;
+
+  /// Whether the job was cancelled.
+  bool get isCancel => cancelled || ReturnCode.isCancel(returnCode);
+
+  /// Whether the worker was terminated by a signal rather than exiting.
+  bool get crashed => returnCode < 0 && !cancelled;
+
+  /// Returns all log messages concatenated into a single string.
+  String getLogsAsString() => logs.map((l) => l.message).join();
+
+  @override
+  String toString() =>
+      'FFmpegProcessResult($jobId, returnCode: $returnCode, duration: $duration)';
+}
+
+/// A job submitted to an [FFmpegProcessPool].
+class FFmpegProcessJob {
+  /// Pool-local job identifier.
+  final int jobId;
+
+  /// Arguments passed to FFmpeg.
+  final List<String> arguments;
+
+  final FFmpegLogCallback? _logCallback;
+  final FFmpegStatisticsCallback? _statisticsCallback;
+  final int? _expectedDurationMs;
+  final Completer<FFmpegProcessResult> _completer =
+      Completer<FFmpegProcessResult>();
+
+  Process? _process;
+  bool _cancelled = false;
+
+  FFmpegProcessJob._(
+    this.jobId,
+    this.arguments,
+    this._logCallback,
+    this._statisticsCallback,
+    this._expectedDurationMs,
+  );
+
+  /// Completes when the worker process exits.
+  Future<FFmpegProcessResult> get result => _completer.future;
+
+  /// Whether the worker process is currently running.
+  bool get isRunning => _process != null && !_completer.isCompleted;
+
+  /// Requests cancellation.
+  ///
+  /// A queued job completes immediately with [SessionCancelledException]; a
+  /// running worker receives `SIGTERM`, which FFmpeg handles by finalizing its
+  /// outputs and exiting.
+  void cancel() {
+    if (_cancelled || _completer.isCompleted) return;
+    _cancelled = true;
+    final process = _process;
+    if (process == null) {
+      _completer.completeError(
+        SessionCancelledException('Job $jobId was removed from the pool queue'),
+      );
+    } else {
+      process.kill(ProcessSignal.sigterm);
+    }
+  }
+}
+
+/// Runs FFmpeg commands in separate operating-system processes.
+///
+/// In-process sessions share FFmpeg's global state, signal handling, and log
+/// redirection with the application, so a crashing filter takes down every
+/// job and global locks limit scaling.  This pool executes each job in its
+/// own worker process instead: a crash only fails that job (reported through
+/// [FFmpegProcessResult.crashed]), and jobs scale across cores without
+/// contending on in-process locks.
+///
+/// Workers report statistics through `-progress pipe:1` and logs through
+/// stderr; both are converted to the same [Statistics] and [Log] objects that
+/// in-process sessions deliver, so existing callbacks can be reused.
+///
+/// This mode runs an FFmpeg command-line executable rather than
+/// libffmpegkit, and returns [FFmpegProcessResult]s rather than [Session]s.
+/// A worker process is started for each job when a slot frees up; nothing
+/// is pre-forked, so every job pays the process start-up cost.  It is only
+/// available on desktop platforms (Linux, macOS, Windows).
+///
+/// ```dart
+/// final pool = FFmpegProcessPool(executable: '/usr/bin/ffmpeg', size: 4);
+/// await pool.start();
+/// final result = await pool.execute(
+///   ['-i', input, '-c:v', 'libx264', output],
+///   statisticsCallback: (s) => print(s.time),
+/// );
+/// if (result.crashed) print('worker crashed: ${result.returnCode}');
+/// await pool.close();
+/// ```
+class FFmpegProcessPool {
+  /// Path of the FFmpeg executable used by every worker.
+  final String executable;
+
+  /// Maximum number of concurrently running workers.
+  final int size;
+
+  /// Extra environment variables passed to every worker.
+  final Map<String, String>? environment;
+
+  final Queue<FFmpegProcessJob> _queue = Queue<FFmpegProcessJob>();
+  final Set<FFmpegProcessJob> _running = <FFmpegProcessJob>{};
+  static int _nextJobId = -1;
+  bool _closed = false;
+  Future<void>? _started;
+
+  /// Creates a pool of up to [size] workers running [executable].
+  ///
+  /// Throws [UnsupportedError] on platforms that cannot spawn processes.
+  FFmpegProcessPool({
+    required this.executable,
+    int? size,
+    this.environment,
+  }) : size = size ?? Platform.numberOfProcessors {
+    if (!(Platform.isLinux || Platform.isMacOS || Platform.isWindows)) {
+      throw UnsupportedError(
+        'FFmpegProcessPool is only supported on desktop platforms',
+      );
+    }
+    if (this.size < 1) {
+      throw ArgumentError.value(size, 'size', 'must be at least 1');
+    }
+  }
+
+  /// Number of running workers.
+  int get activeJobCount => _running.length;
+
+  /// Number of jobs waiting for a free worker.
+  int get queueLength => _queue.length;
+
+  /// Validates [executable] by running `-version` once.
+  ///
+  /// Fails early when the executable is missing or broken, instead of on the
+  /// first job.  Calling [submit] without [start] is allowed; the check then
+  /// happens before the first worker starts.
+  Future<void> start() => _started ??= _validate();
+
+  Future<void> _validate() async {
+    try {
+      final result = await Process.run(executable, const [
+        '-hide_banner',
+        '-version',
+      ], environment: environment);
+      if (result.exitCode != 0) {
+        throw ProcessException(
+          executable,
+          const ['-version'],
+          '${result.stderr}',
+          result.exitCode,
+        );
+      }
+    } catch (e, st) {
+      log(
+        'FFmpegProcessPool.start: error starting $executable',
+        error: e,
+        stackTrace: st,
+      );
+      _started = null;
+      rethrow;
+    }
+  }
+
+  /// Queues [arguments] for execution and returns a handle to the job.
+  ///
+  /// [expectedDurationMs] enables [Statistics.transcodingProgress].
+  FFmpegProcessJob submit(
+    List<String> arguments, {
+    FFmpegLogCallback? logCallback,
+    FFmpegStatisticsCallback? statisticsCallback,
+    int? expectedDurationMs,
+  }) {
+    if (_closed) throw StateError('FFmpegProcessPool is closed');
+    final job = FFmpegProcessJob._(
+      _nextJobId--,
+      List.unmodifiable(arguments),
+      logCallback,
+      statisticsCallback,
+      expectedDurationMs,
+    );
+    _queue.add(job);
+    _pump();
+    return job;
+  }
+
+  /// Executes [arguments] and resolves once the worker exits.
+  Future<FFmpegProcessResult> execute(
+    List<String> arguments, {
+    FFmpegLogCallback? logCallback,
+    FFmpegStatisticsCallback? statisticsCallback,
+    int? expectedDurationMs,
+  }) => submit(
+    arguments,
+    logCallback: logCallback,
+    statisticsCallback: statisticsCallback,
+    expectedDurationMs: expectedDurationMs,
+  ).result;
+
+  /// Cancels every queued and running job.
+  void cancelAll() {
+    for (final job in [..._queue, ..._running]) {
+      job.cancel();
+    }
+    _queue.clear();
+  }
+
+  /// Stops accepting jobs and waits for running ones to finish.
+  Future<void> close({bool cancel = false}) async {
+    _closed = true;
+    if (cancel) cancelAll();
+    await Future.wait([
+      for (final job in [..._queue, ..._running])
+        job.result.then((_) {}, onError: (_) {}),
+    ]);
+  }
+
+  void _pump() {
+    while (_running.length < size && _queue.isNotEmpty) {
+      final job = _queue.removeFirst();
+      if (job._cancelled) continue;
+      _running.add(job);
+      _run(job).whenComplete(() {
+        _running.remove(job);
+        _pump();
+      });
+    }
+  }
+
+  Future<void> _run(FFmpegProcessJob job) async {
+    final logs = <Log>[];
+    Statistics? last;
+    final clock = Stopwatch()..start();
+    try {
+      await start();
+      final process = await Process.start(executable, [
+        '-hide_banner',
+        '-nostdin',
+        '-nostats',
+        '-loglevel',
+        'level+info',
+        '-progress',
+        'pipe:1',
+        ...job.arguments,
+      ], environment: environment);
+      job._process = process;
+      if (job._cancelled) process.kill(ProcessSignal.sigterm);
+
+      final progress = <String, String>{};
+      final stdoutDone = process.stdout
+          .transform(utf8.decoder)
+          .transform(const LineSplitter())
+          .forEach((line) {
+            final eq = line.indexOf('=');
+            if (eq <= 0) return;
+            final key = line.substring(0, eq).trim();
+            progress[key] = line.substring(eq + 1).trim();
+            if (key != 'progress') return;
+            final statistics = parseProgress(
+              job.jobId,
+              progress,
+              clock.elapsedMilliseconds,
+              job._expectedDurationMs,
+            );
+            progress.clear();
+            last = statistics;
+            _guard('statisticsCallback', () {
+              job._statisticsCallback?.call(statistics);
+            });
+          });
+      final stderrDone = process.stderr
+          .transform(utf8.decoder)
+          .transform(const LineSplitter())
+          .forEach((line) {
+            final entry = parseLogLine(job.jobId, line);
+            logs.add(entry);
+            _guard('logCallback', () => job._logCallback?.call(entry));
+          });
+
+      final exitCode = await process.exitCode;
+      await Future.wait([stdoutDone, stderrDone]);
+      clock.stop();
+      if (!job._completer.isCompleted) {
+        job._completer.complete(
+          FFmpegProcessResult._(
+            job.jobId,
+            job.arguments,
+            exitCode,
+            List.unmodifiable(logs),
+            last,
+            clock.elapsed,
+            job._cancelled,
+          ),
+        );
+      }
+    } catch (e, st) {
+      log(
+        'FFmpegProcessPool: error running job ${job.jobId} with $executable',
+        error: e,
+        stackTrace: st,
+      );
+      if (!job._completer.isCompleted) job._completer.completeError(e, st);
+    }
+  }
+
+  void _guard(String name, void Function() body) {
+    try {
+      body();
+    } catch (e, st) {
+      log(
+        'FFmpegProcessPool: error in $name',
+        error: e,
+        stackTrace: st,
+      );
+    }
+  }
+
+  static final RegExp _levelTag = RegExp(
+    r'\[(quiet|panic|fatal|error|warning|info|verbose|debug|trace)\] ',
+  );
+
+  /// Converts a `-loglevel level+...` stderr line into a [Log].
+  @visibleForTesting
+  static Log parseLogLine(int jobId, String line) {
+    final match = _levelTag.firstMatch(line);
+    if (match == null) return Log(jobId, LogLevel.info.value, '$line\n');
+    final level = LogLevel.values.byName(match.group(1)!);
+    final message = line.replaceRange(match.start, match.end, '');
+    return Log(jobId, level.value, '$message\n');
+  }
+
+  /// Converts one `-progress` key/value block into [Statistics].
+  @visibleForTesting
+  static Statistics parseProgress(
+    int jobId,
+    Map<String, String> block,
+    int elapsedMs,
+    int? expectedDurationMs,
+  ) {
+    int intOf(String key) => int.tryParse(block[key] ?? '') ?? 0;
+    double doubleOf(String key, [String suffix = '']) {
+      var value = block[key] ?? '';
+      if (suffix.isNotEmpty && value.endsWith(suffix)) {
+        value = value.substring(0, value.length - suffix.length);
+      }
+      return double.tryParse(value.trim()) ?? 0;
+    }
+
+    // out_time_us and out_time_ms both carry microseconds.
+    final timeMs =
+        (int.tryParse(block['out_time_us'] ?? '') ?? intOf('out_time_ms')) ~/
+        1000;
+    final quality = block.entries
+        .firstWhere(
+          (e) => e.key.startsWith('stream_') && e.key.endsWith('_q'),
+          orElse: () => const MapEntry('', '0'),
+        )
+        .value;
+    final progress = expectedDurationMs == null || expectedDurationMs <= 0
+        ? null
+        : (timeMs / expectedDurationMs).clamp(0.0, 1.0);
+
+    return Statistics(
+      jobId,
+      elapsedMs,
+      timeMs < 0 ? 0 : timeMs,
+      intOf('total_size'),
+      doubleOf('bitrate', 'kbits/s'),
+      doubleOf('speed', 'x'),
+      intOf('frame'),
+      doubleOf('fps'),
+      double.tryParse(quality) ?? 0,
+      intOf('dup_frames'),
+      intOf('drop_frames'),
+      block['progress'] == 'end' && progress != null ? 1.0 : progress,
+    );
+  }
+}
@@ -0,0 +1,403 @@
+/*
+ * FFmpegKit Flutter Extended Plugin - A wrapper library for FFmpeg
+ * Copyright (C) 2026 Akash Patel
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+import 'dart:async';
+import 'dart:developer';
+import 'dart:typed_data';
+
+import 'package:meta/meta.dart';
+
+import 'ffmpeg_pipe.dart';
+import 'ffmpeg_session.dart';
+
+/// A block of interleaved 32-bit float PCM delivered by an [FFplayAudioTap].
+class FFplayAudioBlock {
+  /// Interleaved samples in the range -1.0 to 1.0, [channels] per frame.
+  final Float32List samples;
+
+  /// Number of interleaved channels.
+  final int channels;
+
+  /// Frames per second of [samples], after decimation.
+  final int sampleRate;
+
+  /// Media position of the first frame, in seconds.
+  final double pts;
+
+  const FFplayAudioBlock(
+    this.samples,
+    this.channels,
+    this.sampleRate,
+    this.pts,
+  );
+
+  /// Number of frames in [samples].
+  int get frameCount => samples.length ~/ channels;
+
+  /// Playback time covered by this block.
+  Duration get duration =>
+      Duration(microseconds: frameCount * 1000000 ~/ sampleRate);
+
+  /// Media position just after the last frame, in seconds.
+  double get endPts => pts + frameCount / sampleRate;
+
+  @override
+  String toString() =>
+      'FFplayAudioBlock($frameCount frames x $channels @ $sampleRate Hz, '
+      'pts: $pts)';
+}
+
+/// Fixed-capacity history of the most recent interleaved PCM frames.
+///
+/// Writes overwrite the oldest frames and never wait for a reader, so a slow
+/// consumer sees a gap rather than stalling the producer.  Meant to be read
+/// from an animation tick with [latest], e.g. for VU meters and spectra.
+class PcmRingBuffer {
+  /// Number of interleaved channels.
+  final int channels;
+
+  final Float32List _data;
+  int _written = 0; // frames written since the last clear
+
+  /// Creates a buffer holding up to [capacityFrames] frames.
+  PcmRingBuffer(int capacityFrames, this.channels)
+    : _data = Float32List(capacityFrames * channels) {
+    if (capacityFrames < 1 || channels < 1) {
+      throw ArgumentError('capacityFrames and channels must be at least 1');
+    }
+  }
+
+  /// Maximum number of frames held.
+  int get capacityFrames => _data.length ~/ channels;
+
+  /// Number of frames currently held.
+  int get length => _written < capacityFrames ? _written : capacityFrames;
+
+  /// Frames written since creation or the last [clear].
+  int get totalFrames => _written;
+
+  /// Appends the interleaved [samples], overwriting the oldest frames.
+  void write(Float32List samples) {
+    final capacity = _data.length;
+    var source = samples;
+    if (source.length > capacity) {
+      // Only the tail can survive; skip what would be overwritten anyway.
+      _written += (source.length - capacity) ~/ channels;
+      source = Float32List.sublistView(source, source.length - capacity);
+    }
+    final start = (_written * channels) % capacity;
+    final first = capacity - start < source.length
+        ? capacity - start
+        : source.length;
+    _data.setRange(start, start + first, source);
+    if (first < source.length) {
+      _data.setRange(0, source.length - first, source, first);
+    }
+    _written += source.length ~/ channels;
+  }
+
+  /// Copies the most recent [frames] frames, oldest first.
+  ///
+  /// Returns fewer frames while the buffer is filling.
+  Float32List latest(int frames) {
+    final count = frames < length ? frames : length;
+    final result = Float32List(count * channels);
+    if (count == 0) return result;
+    final capacity = _data.length;
+    final start = ((_written - count) * channels) % capacity;
+    final first = capacity - start < result.length
+        ? capacity - start
+        : result.length;
+    result.setRange(0, first, _data, start);
+    if (first < result.length) {
+      result.setRange(first, result.length, _data);
+    }
+    return result;
+  }
+
+  /// Discards every frame.
+  void clear() => _written = 0;
+}
+
+/// Taps the audio of an FFplay session as interleaved float PCM.
+///
+/// FFplay sends decoded audio straight to the output device, so the tap
+/// decodes the same input in a parallel [FFmpegSession] paced at real time
+/// (`-re`) and reads `f32le` samples from an [FFmpegPipeOutput].  The pipe is
+/// drained continuously and [blocks] never applies back-pressure, so the tap
+/// cannot stall either the player or its own decoder; a listener that falls
+/// behind simply misses blocks, and [ring] always holds the latest history.
+///
+/// Every block carries the media position of its first frame, so it can be
+/// aligned with `FFplaySession.clock`.  Start the tap at the player position
+/// and restart it after seeks — `FFplaySession.addAudioTap` does both.
+///
+/// Because the samples come from a second decode rather than from the audio
+/// FFplay plays, the tap:
+///
+/// * drifts from playback over time, since the two sessions are paced by
+///   different clocks; compare [FFplayAudioBlock.pts] with the player
+///   position rather than assuming they line up;
+/// * doubles the I/O and audio decoding cost of the input;
+/// * cannot tap inputs that can only be opened once, such as pipes or the
+///   `udp://` and `rtp://` ports a live player has bound (see
+///   [supportsInput]).
+///
+/// [decimation] keeps every n-th frame without filtering, which is cheap and
+/// adequate for level meters; for spectra, request a lower [sampleRate]
+/// instead so FFmpeg resamples with anti-aliasing.
+class FFplayAudioTap {
+  /// Media path or URL being tapped.
+  final String input;
+
+  /// Sample rate requested from FFmpeg.
+  final int sampleRate;
+
+  /// Number of interleaved channels requested from FFmpeg.
+  final int channels;
+
+  /// Frames per block before decimation.
+  final int blockFrames;
+
+  /// Keep every [decimation]-th frame; `1` keeps all of them.
+  final int decimation;
+
+  /// Most recent decimated frames.
+  final PcmRingBuffer ring;
+
+  /// Quiet period [seekTo] waits for before restarting the decoder.
+  final Duration restartDelay;
+
+  final StreamController<FFplayAudioBlock> _controller =
+      StreamController<FFplayAudioBlock>.broadcast();
+  FFmpegSession? _session;
+  Timer? _restart;
+  int _generation = 0;
+  double? _latestPts;
+
+  /// Creates a tap for [input] keeping [history] of audio in [ring].
+  FFplayAudioTap(
+    this.input, {
+    this.sampleRate = 48000,
+    this.channels = 2,
+    this.blockFrames = 1024,
+    this.decimation = 1,
+    this.restartDelay = const Duration(milliseconds: 250),
+    Duration history = const Duration(seconds: 2),
+  }) : ring = PcmRingBuffer(
+         (history.inMicroseconds *
+                 sampleRate ~/
+                 (decimation < 1 ? 1 : decimation) ~/
+                 1000000)
+             .clamp(1, 1 << 24),
+         channels < 1 ? 1 : channels,
+       ) {
+    if (sampleRate < 1 || channels < 1 || blockFrames < 1 || decimation < 1) {
+      throw ArgumentError(
+        'sampleRate, channels, blockFrames and decimation must be at least 1',
+      );
+    }
+  }
+
+  /// Blocks as they are decoded.  Broadcast; listeners never slow the tap.
+  Stream<FFplayAudioBlock> get blocks => _controller.stream;
+
+  /// Frames per second of delivered samples.
+  int get outputSampleRate => sampleRate ~/ decimation;
+
+  /// Whether a decoding session is running.
+  bool get isRunning => _session != null;
+
+  /// Whether [input] can be opened a second time alongside the player.
+  ///
+  /// Pipes, descriptors and the datagram ports of live inputs are consumed
+  /// by whichever reader opens them first.
+  static bool supportsInput(String input) {
+    if (input == '-') return false;
+    final scheme = RegExp(r'^([a-z][a-z0-9+.-]*):').firstMatch(input);
+    return !const {'pipe', 'fd', 'udp', 'rtp'}.contains(scheme?.group(1));
+  }
+
+  /// Media position just after the newest frame in [ring], in seconds.
+  double? get latestPts => _latestPts;
+
+  /// FFmpeg arguments decoding [input] from [position] into [output].
+  List<String> buildArguments(double position, String output) => [
+    '-hide_banner',
+    '-re',
+    if (position > 0) ...['-ss', position.toStringAsFixed(3)],
+    '-i',
+    input,
+    '-vn',
+    '-ac',
+    '$channels',
+    '-ar',
+    '$sampleRate',
+    '-f',
+    'f32le',
+    output,
+  ];
+
+  /// Starts decoding at [position] seconds, replacing any running session.
+  ///
+  /// [ring] is cleared so that it never mixes audio from before a seek.
+  void start([double position = 0.0]) {
+    if (_controller.isClosed) throw StateError('FFplayAudioTap is closed');
+    stop();
+    final generation = _generation;
+    ring.clear();
+    _latestPts = null;
+
+    final pipe = FFmpegPipeOutput();
+    final session = FFmpegSession.fromArguments(
+      buildArguments(position, pipe.path),
+    );
+    _session = session;
+    decodeBlocks(
+      pipe.stream,
+      channels: channels,
+      sampleRate: sampleRate,
+      blockFrames: blockFrames,
+      decimation: decimation,
+      startPts: position,
+    ).listen(
+      (block) {
+        if (generation != _generation || _controller.isClosed) return;
+        ring.write(block.samples);
+        _latestPts = block.endPts;
+        _controller.add(block);
+      },
+      onError: (Object e, StackTrace st) {
+        log('FFplayAudioTap: error reading samples', error: e, stackTrace: st);
+      },
+    );
+    FFmpegPipes.executeAsync(session, outputs: [pipe]).then(
+      (_) {
+        if (identical(_session, session)) _session = null;
+      },
+      onError: (Object e, StackTrace st) {
+        if (identical(_session, session)) _session = null;
+        log('FFplayAudioTap: error decoding $input', error: e, stackTrace: st);
+      },
+    );
+  }
+
+  /// Restarts decoding at [position] once no further call has arrived for
+  /// [restartDelay].
+  ///
+  /// Decoding stops at once, so a burst of seeks during a scrub costs one
+  /// restart rather than one FFmpeg session per seek.
+  void seekTo(double position) {
+    if (_controller.isClosed) throw StateError('FFplayAudioTap is closed');
+    stop();
+    _restart = Timer(restartDelay, () {
+      _restart = null;
+      start(position);
+    });
+  }
+
+  /// Stops decoding and cancels a pending [seekTo]; [ring] keeps its
+  /// contents.
+  void stop() {
+    _restart?.cancel();
+    _restart = null;
+    _generation++;
+    final session = _session;
+    _session = null;
+    if (session == null) return;
+    try {
+      session.cancel();
+    } catch (e, st) {
+      log('FFplayAudioTap: error cancelling session', error: e, stackTrace: st);
+    }
+  }
+
+  /// Stops decoding and closes [blocks].
+  Future<void> close() {
+    stop();
+    return _controller.close();
+  }
+
+  /// Splits an `f32le` byte stream into [FFplayAudioBlock]s.
+  ///
+  /// Chunk boundaries may fall anywhere, including inside a sample.  Each
+  /// block holds [blockFrames] input frames (the last one may be shorter)
+  /// and keeps every [decimation]-th frame counted from the start of the
+  /// stream.  Samples are read in host byte order, which is little-endian on
+  /// every supported platform.
+  @visibleForTesting
+  static Stream<FFplayAudioBlock> decodeBlocks(
+    Stream<List<int>> input, {
+    required int channels,
+    required int sampleRate,
+    int blockFrames = 1024,
+    int decimation = 1,
+    double startPts = 0.0,
+  }) async* {
+    final frameBytes = channels * 4;
+    final staging = Uint8List(blockFrames * frameBytes);
+    final samples = staging.buffer.asFloat32List();
+    var fill = 0;
+    var frameIndex = 0; // input frames emitted so far
+    final outputRate = sampleRate ~/ decimation;
+
+    FFplayAudioBlock take(int frames) {
+      // First frame in this block that survives decimation.
+      final skip = (decimation - frameIndex % decimation) % decimation;
+      final kept = frames > skip
+          ? (frames - skip + decimation - 1) ~/ decimation
+          : 0;
+      final out = Float32List(kept * channels);
+      for (var k = 0; k < kept; k++) {
+        final from = (skip + k * decimation) * channels;
+        out.setRange(k * channels, (k + 1) * channels, samples, from);
+      }
+      final block = FFplayAudioBlock(
+        out,
+        channels,
+        outputRate,
+        startPts + (frameIndex + skip) / sampleRate,
+      );
+      frameIndex += frames;
+      return block;
+    }
+
+    await for (final chunk in input) {
+      var offset = 0;
+      while (offset < chunk.length) {
+        final n = staging.length - fill < chunk.length - offset
+            ? staging.length - fill
+            : chunk.length - offset;
+        staging.setRange(fill, fill + n, chunk, offset);
+        fill += n;
+        offset += n;
+        if (fill == staging.length) {
+          final block = take(blockFrames);
+          fill = 0;
+          if (block.samples.isNotEmpty) yield block;
+        }
+      }
+    }
+    final frames = fill ~/ frameBytes;
+    if (frames > 0) {
+      final block = take(frames);
+      if (block.samples.isNotEmpty) yield block;
+    }
+  }
+}
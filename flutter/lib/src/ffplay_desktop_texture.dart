@@ -21,6 +21,187 @@ import 'dart:io' show Platform;
 import 'package:flutter/services.dart';
 import 'package:flutter/widgets.dart';
 
+/// Snapshot of the decoded-frame cache of an [FFplayDesktopTexture].
+class FrameCacheStatistics {
+  /// Byte budget; `0` when the cache is disabled.
+  final int maxBytes;
+
+  /// Bytes held by cached frames.
+  final int bytes;
+
+  /// Number of cached frames.
+  final int entries;
+
+  /// Lookups answered from the cache.
+  final int hits;
+
+  /// Lookups that found no frame within tolerance.
+  final int misses;
+
+  /// Frames dropped to stay within [maxBytes].
+  final int evictions;
+
+  /// Earliest cached position, or `null` when empty.
+  final Duration? first;
+
+  /// Latest cached position, or `null` when empty.
+  final Duration? last;
+
+  const FrameCacheStatistics({
+    this.maxBytes = 0,
+    this.bytes = 0,
+    this.entries = 0,
+    this.hits = 0,
+    this.misses = 0,
+    this.evictions = 0,
+    this.first,
+    this.last,
+  });
+
+  /// Parses the map returned by the `getFrameCacheStats` platform method.
+  factory FrameCacheStatistics.fromMap(Map<String, dynamic> map) {
+    int read(String key) => (map[key] as num?)?.toInt() ?? 0;
+    Duration? position(String key) {
+      final ms = map[key] as num?;
+      return ms == null ? null : Duration(milliseconds: ms.toInt());
+    }
+
+    return FrameCacheStatistics(
+      maxBytes: read('maxBytes'),
+      bytes: read('bytes'),
+      entries: read('entries'),
+      hits: read('hits'),
+      misses: read('misses'),
+      evictions: read('evictions'),
+      first: position('firstMs'),
+      last: position('lastMs'),
+    );
+  }
+
+  /// Fraction of lookups answered from the cache, or `0.0` before any.
+  double get hitRatio => hits + misses == 0 ? 0.0 : hits / (hits + misses);
+
+  @override
+  String toString() =>
+      'FrameCacheStatistics($entries frames, $bytes/$maxBytes bytes, '
+      'hits: $hits, misses: $misses, evictions: $evictions)';
+}
+
+/// How an [FFplayDesktopTexture] handles frames that arrive faster than the
+/// display consumes them.
+enum FramePresentationPolicy {
+  /// Always show the newest queued frame next, dropping the older ones.
+  ///
+  /// Minimises decode-to-display latency whatever the `queueDepth`; use for
+  /// live and interactive playback.
+  latest('dropOldest'),
+
+  /// Drop incoming frames while the queue is full so that every queued
+  /// frame is presented in order.
+  ///
+  /// Smooths motion at the cost of up to `queueDepth` frames of latency.
+  everyFrame('dropNewest');
+
+  /// Value of the `dropPolicy` argument understood by the native plugin.
+  final String wireName;
+
+  const FramePresentationPolicy(this.wireName);
+}
+
+/// Snapshot of the presentation counters of an [FFplayDesktopTexture].
+///
+/// Latency is measured from the moment the native plugin receives a decoded
+/// frame to the moment the render thread uploads it.
+class FramePresentationStatistics {
+  /// Maximum number of frames waiting for the render thread.
+  final int queueDepth;
+
+  /// Active drop policy.
+  final FramePresentationPolicy policy;
+
+  /// Frames currently queued.
+  final int queued;
+
+  /// Frames delivered by the decoder.
+  final int received;
+
+  /// Frames uploaded by the render thread.
+  final int presented;
+
+  /// Frames discarded because the queue was full or, with
+  /// [FramePresentationPolicy.latest], because a newer frame was presented.
+  final int dropped;
+
+  /// Frames decoded in time but presented more than 1.5 frame intervals
+  /// after the previous one.
+  final int janks;
+
+  /// Decode-to-display latency of the last presented frame.
+  final Duration lastLatency;
+
+  /// Mean decode-to-display latency.
+  final Duration averageLatency;
+
+  /// Largest decode-to-display latency observed.
+  final Duration maxLatency;
+
+  /// Smoothed interval between decoded frames.
+  final Duration frameInterval;
+
+  /// Playback position of the last presented frame, or `null` before any.
+  final Duration? lastPosition;
+
+  const FramePresentationStatistics({
+    this.queueDepth = 1,
+    this.policy = FramePresentationPolicy.latest,
+    this.queued = 0,
+    this.received = 0,
+    this.presented = 0,
+    this.dropped = 0,
+    this.janks = 0,
+    this.lastLatency = Duration.zero,
+    this.averageLatency = Duration.zero,
+    this.maxLatency = Duration.zero,
+    this.frameInterval = Duration.zero,
+    this.lastPosition,
+  });
+
+  /// Parses the map returned by the `getPresentationStats` platform method.
+  factory FramePresentationStatistics.fromMap(Map<String, dynamic> map) {
+    int read(String key) => (map[key] as num?)?.toInt() ?? 0;
+    Duration micros(String key) => Duration(microseconds: read(key));
+    final position = (map['lastPositionMs'] as num?)?.toInt() ?? -1;
+
+    return FramePresentationStatistics(
+      queueDepth: read('queueDepth').clamp(1, 16),
+      policy: FramePresentationPolicy.values.firstWhere(
+        (p) => p.wireName == map['dropPolicy'],
+        orElse: () => FramePresentationPolicy.latest,
+      ),
+      queued: read('queued'),
+      received: read('received'),
+      presented: read('presented'),
+      dropped: read('dropped'),
+      janks: read('janks'),
+      lastLatency: micros('lastLatencyUs'),
+      averageLatency: micros('averageLatencyUs'),
+      maxLatency: micros('maxLatencyUs'),
+      frameInterval: micros('frameIntervalUs'),
+      lastPosition: position < 0 ? null : Duration(milliseconds: position),
+    );
+  }
+
+  /// Fraction of received frames that were dropped, or `0.0` before any.
+  double get dropRatio => received == 0 ? 0.0 : dropped / received;
+
+  @override
+  String toString() =>
+      'FramePresentationStatistics(${policy.name}, depth: $queueDepth, '
+      'presented: $presented/$received, dropped: $dropped, janks: $janks, '
+      'latency: ${averageLatency.inMicroseconds}us avg, '
+      '${maxLatency.inMicroseconds}us max)';
+}
+
 /// Flutter [Texture]-backed desktop surface for FFplay video output.
 ///
 /// On Linux and Windows, FFplay renders frames with SDL2 software renderer.
@@ -69,16 +250,28 @@ class FFplayDesktopTexture {
   /// Calling `create` while previous texture is active implicitly releases
   /// that texture first (native side replaces global frame callback).
   /// Returns `null` on Android or if texture creation fails.
-  static Future<FFplayDesktopTexture?> create() async {
+  ///
+  /// On Linux and Windows decoded frames wait in a queue of up to
+  /// [queueDepth] frames (1–16) for the render thread, and [policy] decides
+  /// which frame is dropped when it is full.  The default — one frame,
+  /// [FramePresentationPolicy.latest] — always shows the newest frame.
+  static Future<FFplayDesktopTexture?> create({
+    int queueDepth = 1,
+    FramePresentationPolicy policy = FramePresentationPolicy.latest,
+  }) async {
     if (!Platform.isLinux &&
         !Platform.isWindows &&
         !Platform.isIOS &&
         !Platform.isMacOS) {
       return null;
     }
+    if (queueDepth < 1 || queueDepth > 16) {
+      throw RangeError.range(queueDepth, 1, 16, 'queueDepth');
+    }
     try {
       final result = await _channel.invokeMapMethod<String, dynamic>(
         'createTexture',
+        {'queueDepth': queueDepth, 'dropPolicy': policy.wireName},
       );
       if (result == null) return null;
       final texture = FFplayDesktopTexture._(
@@ -103,6 +296,108 @@ class FFplayDesktopTexture {
   /// platform-agnostic setup code.
   void bindToFFplay() {}
 
+  /// Enables the decoded-frame cache with a budget of [maxBytes], or disables
+  /// it when [maxBytes] is `0`.
+  ///
+  /// Every presented frame is copied into a bounded LRU keyed by its
+  /// playback position, scaled down by [downscale] in each dimension (`1`
+  /// keeps full resolution).  A 1080p RGBA frame takes about 8 MiB at full
+  /// size and 2 MiB at `downscale: 2`.  Reconfiguring drops cached frames
+  /// and statistics.  Only implemented on Linux and Windows.
+  Future<void> configureFrameCache({
+    required int maxBytes,
+    int downscale = 1,
+  }) async {
+    if (!Platform.isLinux && !Platform.isWindows) return;
+    if (maxBytes < 0) {
+      throw ArgumentError.value(maxBytes, 'maxBytes', 'must not be negative');
+    }
+    if (downscale < 1) {
+      throw ArgumentError.value(downscale, 'downscale', 'must be at least 1');
+    }
+    await _channel.invokeMethod<void>('configureFrameCache', {
+      'maxBytes': maxBytes,
+      'downscale': downscale,
+    });
+  }
+
+  /// Presents the cached frame nearest to [seconds] if one lies within
+  /// [tolerance], without involving the decoder.
+  ///
+  /// Returns the position of the frame shown, or `null` on a cache miss.
+  /// Pair it with `FFplaySession.seek` during scrubbing: a hit updates the
+  /// picture immediately, and the seek moves the player itself.
+  Future<double?> showCachedFrame(
+    double seconds, {
+    Duration tolerance = const Duration(milliseconds: 50),
+  }) async {
+    if (!Platform.isLinux && !Platform.isWindows) return null;
+    if (seconds.isNaN || seconds.isInfinite) return null;
+    try {
+      final result = await _channel.invokeMapMethod<String, dynamic>(
+        'showCachedFrame',
+        {
+          'positionMs': (seconds * 1000).round(),
+          'toleranceMs': tolerance.inMilliseconds,
+        },
+      );
+      if (result == null || result['hit'] != true) return null;
+      return (result['positionMs'] as num).toDouble() / 1000;
+    } on PlatformException {
+      return null;
+    }
+  }
+
+  /// Returns the current frame cache statistics, or `null` where the cache
+  /// is not supported.
+  Future<FrameCacheStatistics?> getFrameCacheStatistics() async {
+    if (!Platform.isLinux && !Platform.isWindows) return null;
+    try {
+      final result = await _channel.invokeMapMethod<String, dynamic>(
+        'getFrameCacheStats',
+      );
+      return result == null ? null : FrameCacheStatistics.fromMap(result);
+    } on PlatformException {
+      return null;
+    }
+  }
+
+  /// Returns the current presentation counters, or `null` where they are
+  /// not supported.
+  ///
+  /// A rising [FramePresentationStatistics.janks] count with a low
+  /// [FramePresentationStatistics.dropRatio] points at the render thread; a
+  /// high drop ratio with few janks means the decoder outpaces the display.
+  Future<FramePresentationStatistics?> getPresentationStatistics() async {
+    if (!Platform.isLinux && !Platform.isWindows) return null;
+    try {
+      final result = await _channel.invokeMapMethod<String, dynamic>(
+        'getPresentationStats',
+      );
+      return result == null
+          ? null
+          : FramePresentationStatistics.fromMap(result);
+    } on PlatformException {
+      return null;
+    }
+  }
+
+  /// Stops or restarts delivery of decoded frames to this texture.
+  ///
+  /// While stopped the decoder thread never calls into the plugin and no
+  /// repaint is requested; the texture keeps its last frame.  Use it while
+  /// the view is hidden.  Only implemented on Linux and Windows.
+  Future<void> setFrameDeliveryEnabled(bool enabled) async {
+    if (!Platform.isLinux && !Platform.isWindows) return;
+    try {
+      await _channel.invokeMethod<void>('setFrameDelivery', {
+        'enabled': enabled,
+      });
+    } on PlatformException {
+      // Texture may already be released; ignore.
+    }
+  }
+
   /// Releases native pixel-buffer texture and stops frame delivery.
   /// The native plugin calls `ffplay_set_frame_callback(null, null)` before
   /// unregistering the texture with `TextureRegistrar`.
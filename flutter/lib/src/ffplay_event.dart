@@ -0,0 +1,216 @@
+/*
+ * FFmpegKit Flutter Extended Plugin - A wrapper library for FFmpeg
+ * Copyright (C) 2026 Akash Patel
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/// Playback state reported by [FFplayStateChanged].
+enum FFplayPlaybackState { playing, paused, stopped }
+
+/// A change observed on an FFplay session, delivered by
+/// `FFplaySession.events`.
+sealed class FFplayEvent {
+  const FFplayEvent();
+}
+
+/// The decoded video dimensions changed, typically once the first frame of
+/// the media has been decoded.
+final class FFplayVideoSizeChanged extends FFplayEvent {
+  final int width;
+  final int height;
+
+  const FFplayVideoSizeChanged(this.width, this.height);
+
+  @override
+  String toString() => 'FFplayVideoSizeChanged($width x $height)';
+}
+
+/// Playback started, paused, resumed, or stopped.
+final class FFplayStateChanged extends FFplayEvent {
+  final FFplayPlaybackState state;
+
+  const FFplayStateChanged(this.state);
+
+  @override
+  String toString() => 'FFplayStateChanged(${state.name})';
+}
+
+/// The player is playing but the position has stopped advancing
+/// ([buffering] is `true`), or it advanced again after such a stall.
+final class FFplayBufferingChanged extends FFplayEvent {
+  final bool buffering;
+
+  /// Position in seconds at which the stall started or ended.
+  final double position;
+
+  const FFplayBufferingChanged(this.buffering, this.position);
+
+  @override
+  String toString() => 'FFplayBufferingChanged($buffering at $position)';
+}
+
+/// Playback reached the end of the media.
+final class FFplayEndOfFile extends FFplayEvent {
+  /// Final position in seconds.
+  final double position;
+
+  const FFplayEndOfFile(this.position);
+
+  @override
+  String toString() => 'FFplayEndOfFile($position)';
+}
+
+/// A seek issued through the session has landed.
+final class FFplaySeekComplete extends FFplayEvent {
+  /// Requested target in seconds.
+  final double target;
+
+  /// First position the player reported after the seek.
+  final double position;
+
+  const FFplaySeekComplete(this.target, this.position);
+
+  @override
+  String toString() => 'FFplaySeekComplete($target -> $position)';
+}
+
+/// One sample of the native player's observable state.
+class FFplayStatus {
+  final int width;
+  final int height;
+  final bool playing;
+  final bool paused;
+
+  /// Position in seconds; NaN while a seek is in progress.
+  final double position;
+
+  const FFplayStatus({
+    this.width = 0,
+    this.height = 0,
+    this.playing = false,
+    this.paused = false,
+    this.position = double.nan,
+  });
+}
+
+/// Turns successive [FFplayStatus] samples into [FFplayEvent]s.
+///
+/// Every native query an FFplay session needs is made once per sample and
+/// compared against the previous sample, so consumers of size, state,
+/// buffering, and seek changes share a single poll instead of each running
+/// their own timer.
+class FFplayEventTracker {
+  /// Number of consecutive samples without progress, while playing, before
+  /// [FFplayBufferingChanged] reports a stall.
+  final int stallSamples;
+
+  FFplayStatus? _last;
+  FFplayPlaybackState? _state;
+  double? _seekTarget;
+  double _lastProgress = double.nan;
+  int _stalled = 0;
+  bool _buffering = false;
+  bool _ended = false;
+
+  FFplayEventTracker({this.stallSamples = 3}) {
+    if (stallSamples < 1) {
+      throw ArgumentError.value(stallSamples, 'stallSamples', 'must be >= 1');
+    }
+  }
+
+  /// The last playback state reported, or `null` before the first sample.
+  FFplayPlaybackState? get state => _state;
+
+  /// Whether a stall is currently being reported.
+  bool get isBuffering => _buffering;
+
+  /// Records that a seek to [target] was issued, so the next valid position
+  /// produces [FFplaySeekComplete] and is not treated as a stall or EOF.
+  void seekIssued(double target) {
+    _seekTarget = target;
+    _stalled = 0;
+    _ended = false;
+  }
+
+  /// Compares [status] with the previous sample and returns the resulting
+  /// events in the order they should be delivered.
+  List<FFplayEvent> update(FFplayStatus status) {
+    final events = <FFplayEvent>[];
+    final last = _last;
+    _last = status;
+
+    if (status.width > 0 &&
+        status.height > 0 &&
+        (last == null ||
+            status.width != last.width ||
+            status.height != last.height)) {
+      events.add(FFplayVideoSizeChanged(status.width, status.height));
+    }
+
+    final seekTarget = _seekTarget;
+    if (seekTarget != null && !status.position.isNaN) {
+      _seekTarget = null;
+      _lastProgress = status.position;
+      events.add(FFplaySeekComplete(seekTarget, status.position));
+    }
+
+    final state = status.paused
+        ? FFplayPlaybackState.paused
+        : status.playing
+        ? FFplayPlaybackState.playing
+        : FFplayPlaybackState.stopped;
+    if (state != _state) {
+      _stalled = 0;
+      if (_buffering) events.add(_endBuffering(status.position));
+      final wasPlaying = _state == FFplayPlaybackState.playing;
+      _state = state;
+      events.add(FFplayStateChanged(state));
+      if (wasPlaying &&
+          state == FFplayPlaybackState.stopped &&
+          _seekTarget == null &&
+          !_ended) {
+        _ended = true;
+        events.add(FFplayEndOfFile(_finite(last?.position)));
+      }
+      if (state == FFplayPlaybackState.playing) _ended = false;
+    }
+
+    if (state == FFplayPlaybackState.playing &&
+        _seekTarget == null &&
+        !status.position.isNaN) {
+      if (_lastProgress.isNaN || status.position > _lastProgress) {
+        _lastProgress = status.position;
+        _stalled = 0;
+        if (_buffering) events.add(_endBuffering(status.position));
+      } else if (!_buffering && ++_stalled >= stallSamples) {
+        _buffering = true;
+        events.add(FFplayBufferingChanged(true, status.position));
+      }
+    }
+    return events;
+  }
+
+  FFplayBufferingChanged _endBuffering(double position) {
+    _buffering = false;
+    _stalled = 0;
+    return FFplayBufferingChanged(false, _finite(position));
+  }
+
+  double _finite(double? position) {
+    if (position != null && !position.isNaN) return position;
+    return _lastProgress.isNaN ? 0.0 : _lastProgress;
+  }
+}
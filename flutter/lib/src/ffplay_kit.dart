@@ -68,6 +68,64 @@ class FFplayKit {
     return session;
   }
 
+  /// Executes FFplay with [arguments] asynchronously and starts playback.
+  ///
+  /// Each element is passed to FFplay as one argument, so paths containing
+  /// spaces, quotes or backslashes need no quoting.
+  static Future<FFplaySession> executeWithArgumentsAsync(
+    List<String> arguments, {
+    FFplaySessionCompleteCallback? onComplete,
+    callback_manager.FFmpegLogCallback? onLog,
+  }) async {
+    _sessionCompleter = Completer<void>();
+
+    void wrappedCallback(FFplaySession session) {
+      if (onComplete != null) onComplete(session);
+      if (_activeFFplaySession == session) {
+        _activeFFplaySession = null;
+        _sessionCompleter?.complete();
+        _sessionCompleter = null;
+      }
+    }
+
+    _activeFFplaySession = FFplaySession.createGlobalFromArguments(
+      arguments,
+      completeCallback: wrappedCallback,
+    );
+    if (onLog != null) {
+      _activeFFplaySession!.setLogCallback(onLog);
+    }
+    final session = _activeFFplaySession!;
+    unawaited(session.executeAsync());
+    return session;
+  }
+
+  /// Plays the live [input] with the low-latency [profile].
+  ///
+  /// [options] are added after the profile's, before `-i`.  The command is
+  /// passed as an argument list, so [input] needs no quoting.  Pair the
+  /// returned session with [FFplaySession.monitorLatency] to measure the
+  /// end-to-end delay.
+  ///
+  /// ```dart
+  /// final session = await FFplayKit.executeLive('udp://127.0.0.1:1234');
+  /// final monitor = session.monitorLatency(
+  ///   const FFplayLiveReference.timeOfDay(),
+  /// );
+  /// monitor.latencyStream.listen((l) => print('${l.inMilliseconds} ms'));
+  /// ```
+  static Future<FFplaySession> executeLive(
+    String input, {
+    FFplayLowLatencyProfile profile = const FFplayLowLatencyProfile(),
+    List<String> options = const [],
+    FFplaySessionCompleteCallback? onComplete,
+    callback_manager.FFmpegLogCallback? onLog,
+  }) => executeWithArgumentsAsync(
+    [...profile.arguments, ...options, '-i', input],
+    onComplete: onComplete,
+    onLog: onLog,
+  );
+
   /// Creates a new [FFplaySession] without executing it.
   /// Use [execute] or [executeAsync] to execute the session.
   static Future<FFplaySession> createSession(
@@ -102,6 +160,40 @@ class FFplayKit {
     return _activeFFplaySession!;
   }
 
+  /// Pool of inputs prepared ahead of playback; see [prepare].
+  static FFplayPreparePool preparePool = FFplayPreparePool();
+
+  /// Probes, indexes, and warms the input of an FFplay [command] ahead of
+  /// playback without touching the active session.
+  ///
+  /// Only one FFplay session can play at a time, so call this for the items
+  /// likely to be played next, then start them with [executeAsync] after
+  /// [FFplaySession.prepare] picks up the pooled result.
+  static Future<FFplayPreparedMedia?> prepare(String command) async {
+    final input = FFplayPreparePool.inputOf(command);
+    return input == null ? null : preparePool.prepare(input);
+  }
+
+  /// Probes [items] and plays them gaplessly through one session.
+  ///
+  /// See [FFplayPlaylist] for how items are joined and prebuffered.
+  static Future<FFplayPlaylist> executePlaylist(
+    List<String> items, {
+    List<String> options = const [],
+    int prebufferDepth = 1,
+    int maxPrebufferBytes = 16 * 1024 * 1024,
+    FFplaySessionCompleteCallback? onComplete,
+    callback_manager.FFmpegLogCallback? onLog,
+  }) async {
+    final playlist = await FFplayPlaylist.create(
+      items,
+      prebufferDepth: prebufferDepth,
+      maxPrebufferBytes: maxPrebufferBytes,
+    );
+    await playlist.play(options: options, onComplete: onComplete, onLog: onLog);
+    return playlist;
+  }
+
   /// Cancels a [session] if it is currently running.
   static void cancel(FFplaySession session) => session.cancel();
 
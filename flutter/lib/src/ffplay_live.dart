@@ -0,0 +1,238 @@
+/*
+ * FFmpegKit Flutter Extended Plugin - A wrapper library for FFmpeg
+ * Copyright (C) 2026 Akash Patel
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+import 'dart:async';
+
+/// FFplay options that trade robustness for latency on live inputs.
+///
+/// The defaults disable input buffering and stream probing, drop frames that
+/// are already late, and slave playback to FFplay's external clock.  For
+/// real-time inputs (`udp://`, `rtp://`, `rtsp://`, SDP) FFplay then nudges
+/// that clock between 0.9x and 1.01x speed to keep its packet queues a few
+/// packets deep, so the delay does not grow when the sender and the display
+/// run at slightly different rates.
+class FFplayLowLatencyProfile {
+  /// Bytes read to detect the input format; `32` is the minimum.
+  final int probeSize;
+
+  /// Time spent analysing streams before playback; zero skips analysis.
+  final Duration analyzeDuration;
+
+  /// Whether frames that are late for display are dropped.
+  final bool dropLateFrames;
+
+  /// Whether playback follows FFplay's external clock, which adapts its
+  /// speed to the buffer depth of real-time inputs.
+  final bool externalClock;
+
+  /// Creates a profile; the defaults give the lowest delay.
+  const FFplayLowLatencyProfile({
+    this.probeSize = 32,
+    this.analyzeDuration = Duration.zero,
+    this.dropLateFrames = true,
+    this.externalClock = true,
+  });
+
+  /// FFplay arguments to place before `-i`.
+  List<String> get arguments => [
+    '-fflags',
+    'nobuffer',
+    '-flags',
+    'low_delay',
+    '-probesize',
+    '${probeSize < 32 ? 32 : probeSize}',
+    '-analyzeduration',
+    '${analyzeDuration.inMicroseconds}',
+    if (dropLateFrames) '-framedrop',
+    if (externalClock) ...['-sync', 'ext'],
+  ];
+
+  /// [arguments] as a command-line fragment.
+  String get options => arguments.join(' ');
+
+  @override
+  String toString() => 'FFplayLowLatencyProfile($options)';
+}
+
+/// Maps the media position of a live stream to the wall-clock time at which
+/// that content was captured.
+abstract class FFplayLiveReference {
+  const FFplayLiveReference();
+
+  /// Content at [position] was captured at [time]; the stream advances in
+  /// real time from there.
+  ///
+  /// Use it when the sender's start time is known, e.g. a local test sender
+  /// whose timestamps start at zero: `FFplayLiveReference.anchored(0, t0)`.
+  const factory FFplayLiveReference.anchored(double position, DateTime time) =
+      _AnchoredReference;
+
+  /// Timestamps are UTC seconds since midnight.
+  ///
+  /// The sender stamps them with `-output_ts_offset` set to
+  /// [timeOfDayOffset] when it starts; MPEG-TS timestamps hold a full day
+  /// without wrapping.
+  const factory FFplayLiveReference.timeOfDay() = _TimeOfDayReference;
+
+  /// Seconds since UTC midnight at [now] (default: the current time), for
+  /// the sender's `-output_ts_offset`.
+  static double timeOfDayOffset([DateTime? now]) {
+    final utc = (now ?? DateTime.now()).toUtc();
+    final midnight = DateTime.utc(utc.year, utc.month, utc.day);
+    return utc.difference(midnight).inMicroseconds / 1e6;
+  }
+
+  /// Wall-clock time at which the content at [position] was captured, given
+  /// the current time [now].
+  DateTime captureTimeOf(double position, DateTime now);
+}
+
+class _AnchoredReference extends FFplayLiveReference {
+  final double position;
+  final DateTime time;
+
+  const _AnchoredReference(this.position, this.time);
+
+  @override
+  DateTime captureTimeOf(double position, DateTime now) => time.add(
+    Duration(microseconds: ((position - this.position) * 1e6).round()),
+  );
+}
+
+class _TimeOfDayReference extends FFplayLiveReference {
+  const _TimeOfDayReference();
+
+  @override
+  DateTime captureTimeOf(double position, DateTime now) {
+    final utc = now.toUtc();
+    var capture = DateTime.utc(
+      utc.year,
+      utc.month,
+      utc.day,
+    ).add(Duration(microseconds: (position * 1e6).round()));
+    // Pick the day that puts the capture closest to now (midnight rollover).
+    final gap = capture.difference(utc);
+    if (gap > const Duration(hours: 12)) {
+      capture = capture.subtract(const Duration(days: 1));
+    } else if (gap < const Duration(hours: -12)) {
+      capture = capture.add(const Duration(days: 1));
+    }
+    return capture;
+  }
+}
+
+/// Measures the end-to-end latency of a live stream: the time between
+/// capture and display of the content currently shown.
+///
+/// Samples [position] every [interval] while [latencyStream] has listeners,
+/// or on demand through [sample].  The latency is `now` minus the capture
+/// time of the displayed position according to [reference], so it includes
+/// encoding, transport, buffering, and decoding delay.
+class FFplayLatencyMonitor {
+  /// Reads the displayed media position in seconds.
+  final double Function() position;
+
+  /// Maps positions to capture times.
+  final FFplayLiveReference reference;
+
+  /// Sampling period of [latencyStream].
+  final Duration interval;
+
+  /// Latency the stream is expected to stay under.
+  final Duration target;
+
+  final DateTime Function() _now;
+  late final StreamController<Duration> _controller =
+      StreamController<Duration>.broadcast(
+        onListen: _startTimer,
+        onCancel: _stopTimer,
+      );
+  Timer? _timer;
+  Duration? _current;
+  double? _smoothedUs;
+  Duration _max = Duration.zero;
+  int _samples = 0;
+
+  /// Creates a monitor; [now] overrides the wall clock for tests.
+  FFplayLatencyMonitor(
+    this.position,
+    this.reference, {
+    this.interval = const Duration(milliseconds: 500),
+    this.target = const Duration(milliseconds: 500),
+    DateTime Function()? now,
+  }) : _now = now ?? DateTime.now;
+
+  /// Latency samples; sampling runs only while this has listeners.
+  Stream<Duration> get latencyStream => _controller.stream;
+
+  /// The last measured latency, or `null` before the first sample.
+  Duration? get current => _current;
+
+  /// Exponentially smoothed latency, or `null` before the first sample.
+  Duration? get smoothed {
+    final us = _smoothedUs;
+    return us == null ? null : Duration(microseconds: us.round());
+  }
+
+  /// Largest latency measured.
+  Duration get max => _max;
+
+  /// Number of valid samples taken.
+  int get sampleCount => _samples;
+
+  /// Whether the smoothed latency exceeds [target].
+  bool get isAboveTarget => (smoothed ?? Duration.zero) > target;
+
+  /// Measures the latency now, or returns `null` if no position is known.
+  Duration? sample() {
+    final pos = position();
+    if (pos.isNaN || pos.isInfinite || pos <= 0.0) return null;
+    final now = _now();
+    final latency = now.difference(reference.captureTimeOf(pos, now));
+    _current = latency;
+    final us = latency.inMicroseconds.toDouble();
+    final smoothed = _smoothedUs;
+    _smoothedUs = smoothed == null ? us : smoothed * 0.8 + us * 0.2;
+    if (latency > _max) _max = latency;
+    _samples++;
+    if (!_controller.isClosed) _controller.add(latency);
+    return latency;
+  }
+
+  /// Stops sampling and closes [latencyStream].
+  Future<void> close() {
+    _stopTimer();
+    return _controller.close();
+  }
+
+  void _startTimer() {
+    _timer ??= Timer.periodic(interval, (_) => sample());
+  }
+
+  void _stopTimer() {
+    _timer?.cancel();
+    _timer = null;
+  }
+
+  @override
+  String toString() =>
+      'FFplayLatencyMonitor(current: ${_current?.inMilliseconds} ms, '
+      'smoothed: ${smoothed?.inMilliseconds} ms, '
+      'max: ${_max.inMilliseconds} ms)';
+}
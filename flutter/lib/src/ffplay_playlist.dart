@@ -0,0 +1,302 @@
+/*
+ * FFmpegKit Flutter Extended Plugin - A wrapper library for FFmpeg
+ * Copyright (C) 2026 Akash Patel
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+import 'dart:async';
+import 'dart:developer';
+import 'dart:io';
+
+import 'package:path/path.dart' as p;
+
+import 'callback_manager.dart';
+import 'ffplay_event.dart';
+import 'ffplay_kit.dart';
+import 'ffplay_prepare.dart';
+import 'ffplay_session.dart';
+import 'ffprobe_kit.dart';
+
+/// Gapless playback of several inputs through one FFplay session.
+///
+/// The items are written to an `ffconcat` list and played with the concat
+/// demuxer, so a single player keeps the same audio device and video output
+/// across item boundaries and the next item's packets follow the previous
+/// item's without a teardown.  Item durations are probed up front; they are
+/// written to the list so that the demuxer does not reprobe on seeks, and
+/// they map the playback position to [currentIndex].
+///
+/// While an item plays, the next [prebufferDepth] items are prepared through
+/// a private [FFplayPreparePool], which probes them and reads their opening
+/// blocks into the page cache.  [maxPrebufferBytes] caps the bytes read for
+/// all of them together.
+///
+/// All items should share codecs and stream layout, as the concat demuxer
+/// requires; mixed inputs play, but may glitch at boundaries.
+///
+/// ```dart
+/// final playlist = await FFplayKit.executePlaylist([intro, chapter1, outro]);
+/// playlist.currentIndexStream.listen((i) => print('now playing item $i'));
+/// playlist.next();
+/// ```
+class FFplayPlaylist {
+  /// The inputs, in playback order.
+  final List<String> items;
+
+  /// Start offset of each item in seconds, relative to the playlist.
+  final List<double> starts;
+
+  /// Total playlist duration in seconds.
+  final double duration;
+
+  /// Number of upcoming items kept prepared.
+  final int prebufferDepth;
+
+  /// Upper bound on the bytes read to prebuffer upcoming items.
+  final int maxPrebufferBytes;
+
+  final FFplayPreparePool _pool;
+  final StreamController<int> _indexController =
+      StreamController<int>.broadcast();
+  final Directory _scratch;
+
+  FFplaySession? _session;
+  StreamSubscription<FFplayEvent>? _events;
+  Timer? _boundaryTimer;
+  int _currentIndex = 0;
+
+  FFplayPlaylist._(
+    this.items,
+    this.starts,
+    this.duration,
+    this.prebufferDepth,
+    this.maxPrebufferBytes,
+    this._scratch,
+  ) : _pool = FFplayPreparePool(
+        capacity: prebufferDepth,
+        warmBytes: maxPrebufferBytes ~/ prebufferDepth,
+        buildKeyframeIndex: false,
+      );
+
+  /// Probes [items] and writes their `ffconcat` list.
+  ///
+  /// Throws an [ArgumentError] if [items] is empty or [prebufferDepth] is
+  /// below one, or a [StateError] if the duration of an item cannot be
+  /// determined.
+  static Future<FFplayPlaylist> create(
+    List<String> items, {
+    int prebufferDepth = 1,
+    int maxPrebufferBytes = 16 * 1024 * 1024,
+  }) async {
+    if (items.isEmpty) {
+      throw ArgumentError.value(items, 'items', 'must not be empty');
+    }
+    if (prebufferDepth < 1) {
+      throw ArgumentError.value(
+        prebufferDepth,
+        'prebufferDepth',
+        'must be at least 1',
+      );
+    }
+    final durations = <double>[];
+    for (final item in items) {
+      final info = await FFprobeKit.getCachedMediaInformation(item);
+      final duration = double.tryParse(info?.duration ?? '');
+      if (duration == null || duration <= 0) {
+        throw StateError('Cannot determine the duration of $item');
+      }
+      durations.add(duration);
+    }
+    final starts = offsetsOf(durations);
+
+    final scratch = await Directory.systemTemp.createTemp('ffplay_playlist');
+    await File(
+      p.join(scratch.path, 'playlist.ffconcat'),
+    ).writeAsString(buildConcatList(items, durations), flush: true);
+    return FFplayPlaylist._(
+      List.unmodifiable(items),
+      List.unmodifiable(starts),
+      starts.last + durations.last,
+      prebufferDepth,
+      maxPrebufferBytes,
+      scratch,
+    );
+  }
+
+  /// The session playing this playlist, or `null` before [play].
+  FFplaySession? get session => _session;
+
+  /// Path of the generated `ffconcat` list.
+  String get listPath => p.join(_scratch.path, 'playlist.ffconcat');
+
+  /// Index of the item at the current playback position.
+  int get currentIndex => _currentIndex;
+
+  /// Emits [currentIndex] whenever playback crosses into another item.
+  /// Closes when playback ends.
+  Stream<int> get currentIndexStream => _indexController.stream;
+
+  /// Starts playback through [FFplayKit], replacing any active session.
+  ///
+  /// [options] are FFplay arguments placed before the input, such as
+  /// `['-autoexit']`.
+  Future<FFplaySession> play({
+    List<String> options = const [],
+    FFplaySessionCompleteCallback? onComplete,
+    FFmpegLogCallback? onLog,
+  }) async {
+    if (_session != null) throw StateError('Playlist is already playing');
+    final session = await FFplayKit.executeWithArgumentsAsync(
+      [...options, '-f', 'concat', '-safe', '0', '-i', listPath],
+      onComplete: (s) {
+        _finish();
+        onComplete?.call(s);
+      },
+      onLog: onLog,
+    );
+    _session = session;
+    _events = session.events.listen((event) {
+      if (event is FFplaySeekComplete || event is FFplayStateChanged) {
+        _updateIndex();
+      }
+    });
+    _indexController.add(0);
+    _prebuffer(0);
+    _armBoundary();
+    return session;
+  }
+
+  /// Seeks to the start of the item at [index].
+  void skipTo(int index) {
+    RangeError.checkValidIndex(index, items, 'index');
+    final session = _session;
+    if (session == null) return;
+    session.seek(starts[index]);
+    _updateIndex(starts[index]);
+  }
+
+  /// Seeks to the start of the next item, if any.
+  void next() {
+    if (_currentIndex + 1 < items.length) skipTo(_currentIndex + 1);
+  }
+
+  /// Seeks to the start of the current item, or of the previous item when
+  /// playback is within [threshold] seconds of the current item's start.
+  void previous({double threshold = 3.0}) {
+    final position = _session?.clock.position ?? 0.0;
+    final offset = position - starts[_currentIndex];
+    skipTo(
+      offset < threshold && _currentIndex > 0
+          ? _currentIndex - 1
+          : _currentIndex,
+    );
+  }
+
+  /// Start offsets of items with the given [durations].
+  static List<double> offsetsOf(List<double> durations) {
+    final starts = <double>[];
+    var offset = 0.0;
+    for (final duration in durations) {
+      starts.add(offset);
+      offset += duration;
+    }
+    return starts;
+  }
+
+  /// Index of the item containing [position] given item [starts].
+  static int indexAt(List<double> starts, double position) {
+    var low = 0, high = starts.length - 1;
+    while (low < high) {
+      final mid = (low + high + 1) >> 1;
+      if (starts[mid] <= position) {
+        low = mid;
+      } else {
+        high = mid - 1;
+      }
+    }
+    return low;
+  }
+
+  /// Builds an `ffconcat` list playing [items] with the given [durations].
+  static String buildConcatList(List<String> items, List<double> durations) {
+    final buffer = StringBuffer('ffconcat version 1.0\n');
+    for (var i = 0; i < items.length; i++) {
+      final path = p.isAbsolute(items[i]) || items[i].contains('://')
+          ? items[i]
+          : p.absolute(items[i]);
+      buffer
+        ..writeln("file '${path.replaceAll("'", r"'\''")}'")
+        ..writeln('duration ${durations[i]}');
+    }
+    return buffer.toString();
+  }
+
+  void _updateIndex([double? position]) {
+    final session = _session;
+    if (session == null) return;
+    final index = indexAt(starts, position ?? session.clock.position);
+    if (index != _currentIndex) {
+      _currentIndex = index;
+      if (!_indexController.isClosed) _indexController.add(index);
+      _prebuffer(index);
+    }
+    _armBoundary();
+  }
+
+  /// Schedules one wakeup at the next item boundary while playing.
+  void _armBoundary() {
+    _boundaryTimer?.cancel();
+    _boundaryTimer = null;
+    final session = _session;
+    final nextIndex = _currentIndex + 1;
+    if (session == null ||
+        !session.clock.isRunning ||
+        nextIndex >= items.length) {
+      return;
+    }
+    final remaining = starts[nextIndex] - session.clock.position;
+    final micros = (remaining / session.clock.rate * 1e6).ceil();
+    _boundaryTimer = Timer(
+      Duration(microseconds: micros < 0 ? 0 : micros),
+      _updateIndex,
+    );
+  }
+
+  void _prebuffer(int index) {
+    final upcoming = items.skip(index + 1).take(prebufferDepth);
+    if (upcoming.isEmpty) return;
+    unawaited(_pool.prefetch(upcoming));
+  }
+
+  void _finish() {
+    _boundaryTimer?.cancel();
+    _boundaryTimer = null;
+    unawaited(_events?.cancel());
+    _events = null;
+    _pool.clear();
+    if (!_indexController.isClosed) _indexController.close();
+    unawaited(
+      _scratch.delete(recursive: true).catchError((Object e, StackTrace st) {
+        log(
+          'FFplayPlaylist: error deleting ${_scratch.path}',
+          error: e,
+          stackTrace: st,
+        );
+        return _scratch;
+      }),
+    );
+  }
+}
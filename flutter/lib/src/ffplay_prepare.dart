@@ -0,0 +1,276 @@
+/*
+ * FFmpegKit Flutter Extended Plugin - A wrapper library for FFmpeg
+ * Copyright (C) 2026 Akash Patel
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+import 'dart:async';
+import 'dart:collection';
+import 'dart:developer';
+import 'dart:io';
+import 'dart:math' as math;
+import 'dart:typed_data';
+
+import 'ffmpeg_kit_extended.dart';
+import 'ffprobe_kit.dart';
+import 'keyframe_index.dart';
+import 'media_information.dart';
+import 'read_ahead_input.dart';
+
+/// Everything gathered about an FFplay input ahead of playback.
+class FFplayPreparedMedia {
+  /// The input path or URL.
+  final String input;
+
+  /// Probed media information, or `null` if probing failed.
+  final MediaInformation? mediaInformation;
+
+  /// Keyframe index of the first video stream, or `null` for remote inputs,
+  /// audio-only media, or when indexing was not requested.
+  final KeyframeIndex? keyframeIndex;
+
+  /// Number of bytes read to warm the operating system's page cache.
+  final int warmedBytes;
+
+  /// Time spent preparing.
+  final Duration elapsed;
+
+  const FFplayPreparedMedia._(
+    this.input,
+    this.mediaInformation,
+    this.keyframeIndex,
+    this.warmedBytes,
+    this.elapsed,
+  );
+
+  /// Media duration in seconds, or `0.0` when unknown.
+  double get duration =>
+      double.tryParse(mediaInformation?.duration ?? '') ?? 0.0;
+
+  /// Dimensions of the first video stream, or `null` for audio-only media.
+  (int, int)? get videoSize {
+    for (final stream in mediaInformation?.streams ?? const []) {
+      final width = stream.width, height = stream.height;
+      if (stream.type == 'video' && width != null && height != null) {
+        return (width, height);
+      }
+    }
+    return null;
+  }
+
+  @override
+  String toString() =>
+      'FFplayPreparedMedia($input, duration: $duration, '
+      'warmed: $warmedBytes, elapsed: ${elapsed.inMilliseconds} ms)';
+}
+
+/// Prepares FFplay inputs ahead of playback and keeps the most recent ones.
+///
+/// Preparing an input probes it through [FFprobeKit]'s media information
+/// cache, builds its keyframe index, and reads the start of the file (and
+/// the end, when the `moov` atom trails the media data) so that the blocks
+/// FFplay opens with are already in the page cache.  This moves the probe and
+/// the cold first reads off the interaction path; only decoder start-up
+/// remains when playback begins.
+///
+/// The pool holds up to [capacity] prepared inputs, evicting the least
+/// recently used one.  Concurrent requests for the same input share one
+/// preparation.  A scrolling list can call [prefetch] with the items around
+/// the viewport:
+///
+/// ```dart
+/// FFplayKit.preparePool.prefetch(visibleItems.map((i) => i.path));
+/// ...
+/// final session = await FFplayKit.createSession('-i "$path"');
+/// await session.prepare();
+/// await session.executeAsync();
+/// ```
+class FFplayPreparePool {
+  /// Maximum number of prepared inputs kept.
+  final int capacity;
+
+  /// Bytes read from a local file to warm the page cache, split between its
+  /// head and tail when the index trails the media data.
+  final int warmBytes;
+
+  /// Whether to build a keyframe index for local files.
+  final bool buildKeyframeIndex;
+
+  final LinkedHashMap<String, Future<FFplayPreparedMedia>> _entries =
+      LinkedHashMap();
+
+  static const int _warmChunk = 64 * 1024;
+
+  /// Creates a new [FFplayPreparePool].
+  FFplayPreparePool({
+    this.capacity = 4,
+    this.warmBytes = 4 * 1024 * 1024,
+    this.buildKeyframeIndex = true,
+  }) {
+    if (capacity < 1) {
+      throw ArgumentError.value(capacity, 'capacity', 'must be at least 1');
+    }
+  }
+
+  /// Inputs currently held, from least to most recently used.
+  List<String> get inputs => _entries.keys.toList();
+
+  /// Prepares [input], or returns the pooled preparation.
+  Future<FFplayPreparedMedia> prepare(String input) {
+    final existing = _entries.remove(input);
+    final future = existing ?? _prepare(input);
+    _entries[input] = future;
+    while (_entries.length > capacity) {
+      _entries.remove(_entries.keys.first);
+    }
+    return future;
+  }
+
+  /// Prepares [inputs] one at a time in order, most likely first.
+  ///
+  /// Only the first [capacity] inputs are prepared, so passing the items
+  /// around a scroll position keeps the pool focused on them.
+  Future<void> prefetch(Iterable<String> inputs) async {
+    final wanted = inputs.take(capacity).toList();
+    for (final input in wanted.reversed) {
+      // Touch in reverse so the most likely input ends up most recent.
+      final existing = _entries.remove(input);
+      if (existing != null) _entries[input] = existing;
+    }
+    for (final input in wanted) {
+      try {
+        await prepare(input);
+      } catch (e, st) {
+        log(
+          'FFplayPreparePool: error preparing $input',
+          error: e,
+          stackTrace: st,
+        );
+      }
+    }
+  }
+
+  /// Returns the pooled preparation of [input] without starting one.
+  Future<FFplayPreparedMedia>? lookup(String input) => _entries[input];
+
+  /// Drops [input] from the pool.
+  void evict(String input) => _entries.remove(input);
+
+  /// Drops every pooled input.
+  void clear() => _entries.clear();
+
+  /// Extracts the input of an FFplay [command]: the argument after `-i`, or
+  /// the last argument that is not an option.
+  static String? inputOf(String command) {
+    final args = FFmpegKitExtended.parseArguments(command);
+    final flag = args.indexOf('-i');
+    if (flag >= 0 && flag + 1 < args.length) return args[flag + 1];
+    final input = args.lastWhere((a) => !a.startsWith('-'), orElse: () => '');
+    return input.isEmpty ? null : input;
+  }
+
+  Future<FFplayPreparedMedia> _prepare(String input) async {
+    final stopwatch = Stopwatch()..start();
+    final isLocal = await File(input).exists();
+
+    final warming = isLocal ? _warm(input) : Future.value(0);
+    final probing = FFprobeKit.getCachedMediaInformation(input).catchError((
+      Object e,
+      StackTrace st,
+    ) {
+      log('FFplayPreparePool: error probing $input', error: e, stackTrace: st);
+      return null;
+    });
+    final info = await probing;
+
+    KeyframeIndex? index;
+    final hasVideo = info?.streams.any((s) => s.type == 'video') ?? false;
+    if (isLocal && hasVideo && buildKeyframeIndex) {
+      try {
+        index = await FFprobeKit.getKeyframeIndex(input);
+      } catch (e, st) {
+        log(
+          'FFplayPreparePool: error indexing $input',
+          error: e,
+          stackTrace: st,
+        );
+      }
+    }
+
+    final warmed = await warming;
+    stopwatch.stop();
+    return FFplayPreparedMedia._(
+      input,
+      info,
+      index,
+      warmed,
+      stopwatch.elapsed,
+    );
+  }
+
+  Future<int> _warm(String path) async {
+    RandomAccessFile? file;
+    try {
+      file = await File(path).open();
+      final length = await file.length();
+      final budget = math.min(warmBytes, length);
+      // When the index trails the media data FFplay reads it first, so half
+      // of the budget goes to the tail.
+      final tailBytes =
+          length > warmBytes && !await ReadAheadInput.isSequential(path)
+          ? budget ~/ 2
+          : 0;
+      final chunk = Uint8List(math.max(1, math.min(budget, _warmChunk)));
+      var warmed = await _readAndDiscard(file, 0, budget - tailBytes, chunk);
+      if (tailBytes > 0) {
+        warmed += await _readAndDiscard(
+          file,
+          length - tailBytes,
+          tailBytes,
+          chunk,
+        );
+      }
+      return warmed;
+    } on FileSystemException catch (e, st) {
+      log('FFplayPreparePool: error warming $path', error: e, stackTrace: st);
+      return 0;
+    } finally {
+      await file?.close();
+    }
+  }
+
+  /// Reads [count] bytes from [offset] through the reused [chunk], only to
+  /// pull them into the page cache.
+  static Future<int> _readAndDiscard(
+    RandomAccessFile file,
+    int offset,
+    int count,
+    Uint8List chunk,
+  ) async {
+    await file.setPosition(offset);
+    var read = 0;
+    while (read < count) {
+      final n = await file.readInto(
+        chunk,
+        0,
+        math.min(chunk.length, count - read),
+      );
+      if (n == 0) break;
+      read += n;
+    }
+    return read;
+  }
+}
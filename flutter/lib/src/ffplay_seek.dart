@@ -0,0 +1,218 @@
+/*
+ * FFmpegKit Flutter Extended Plugin - A wrapper library for FFmpeg
+ * Copyright (C) 2026 Akash Patel
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+import 'dart:async';
+
+import 'keyframe_index.dart';
+
+/// How a seek trades latency against precision.
+///
+/// The mode only chooses the target handed to the player.  FFplay itself
+/// always resumes from a keyframe at or before that target, so no mode
+/// gives frame-accurate positioning.
+enum FFplaySeekMode {
+  /// Target the nearest keyframe, before or after the requested position.
+  keyframe,
+
+  /// Target the requested position; FFplay resumes from the keyframe at or
+  /// before it, so unlike [keyframe] this never lands past the request.
+  accurate,
+
+  /// Target the nearest keyframe now, then the requested position once
+  /// requests stop arriving — but only if the player would land later than
+  /// the first seek (see [FFplaySeekScheduler.seeksExactly]).  With FFplay's
+  /// keyframe seeking the refine step is therefore skipped and this mode
+  /// behaves like [keyframe].
+  fastThenRefine,
+}
+
+/// Coalesces a burst of seek requests into the few the player can keep up
+/// with.
+///
+/// At most one seek is issued per [minInterval]; a request arriving sooner
+/// replaces any request still waiting, so a drag producing 60 requests per
+/// second never queues more than one.  Keyframe snapping uses
+/// [keyframeIndex] when it is set and falls back to the exact position
+/// otherwise.
+class FFplaySeekScheduler {
+  final void Function(double seconds) _issue;
+
+  /// Minimum spacing between issued seeks.
+  final Duration minInterval;
+
+  /// Quiet period after which a [FFplaySeekMode.fastThenRefine] request is
+  /// refined to its exact position.
+  final Duration refineDelay;
+
+  /// Keyframe times used to snap fast seeks, if known.
+  KeyframeIndex? keyframeIndex;
+
+  /// Whether the issue callback positions exactly on its target.
+  ///
+  /// `false` for FFplay, which resumes from the keyframe at or before the
+  /// target; [FFplaySeekMode.fastThenRefine] then never refines, since the
+  /// refined seek would land on or before the snapped keyframe.
+  final bool seeksExactly;
+
+  final Stopwatch _sinceIssue = Stopwatch();
+  Timer? _pendingTimer;
+  Timer? _refineTimer;
+  Completer<double?>? _refineCompleter;
+  double? _pendingTarget;
+  Completer<double?>? _pendingCompleter;
+  int _generation = 0;
+  int _issued = 0;
+  int _superseded = 0;
+
+  /// Creates a scheduler that hands seeks to [issue].
+  FFplaySeekScheduler(
+    this._issue, {
+    this.minInterval = const Duration(milliseconds: 33),
+    this.refineDelay = const Duration(milliseconds: 150),
+    this.keyframeIndex,
+    this.seeksExactly = false,
+  });
+
+  /// Number of seeks handed to the player.
+  int get issuedCount => _issued;
+
+  /// Number of requests dropped in favour of a newer one.
+  int get supersededCount => _superseded;
+
+  /// Requests a seek to [seconds] using [mode].
+  ///
+  /// Resolves with the position finally issued for this request, or `null`
+  /// if a newer request superseded it first.
+  Future<double?> request(double seconds, FFplaySeekMode mode) {
+    if (seconds.isNaN || seconds.isInfinite) return Future.value(null);
+    final generation = ++_generation;
+    _cancelRefine();
+    final fast = mode == FFplaySeekMode.accurate ? seconds : snap(seconds);
+    final future = _schedule(fast);
+    // Refining is pointless unless the player would land later than the
+    // fast seek: a keyframe-seeking player resumes from the keyframe before
+    // [seconds], which for a forward snap is behind the frame shown.
+    if (mode != FFplaySeekMode.fastThenRefine ||
+        fast == seconds ||
+        landing(seconds) <= fast) {
+      return future;
+    }
+    return future.then((issued) {
+      if (issued == null) return null;
+      if (generation != _generation) {
+        _superseded++;
+        return null;
+      }
+      final refined = _refineCompleter = Completer<double?>();
+      _refineTimer = Timer(refineDelay, () {
+        _refineTimer = null;
+        _refineCompleter = null;
+        refined.complete(_schedule(seconds));
+      });
+      return refined.future;
+    });
+  }
+
+  /// Nearest keyframe to [seconds], or [seconds] without a [keyframeIndex].
+  double snap(double seconds) {
+    final index = keyframeIndex;
+    if (index == null || index.isEmpty) return seconds;
+    final before = index.keyframeBefore(seconds);
+    final after = index.keyframeAfter(seconds);
+    if (before == null) return after ?? seconds;
+    if (after == null) return before;
+    return seconds - before <= after - seconds ? before : after;
+  }
+
+  /// Where the player resumes after seeking to [seconds]: [seconds] itself
+  /// when it [seeksExactly] or without a [keyframeIndex], otherwise the
+  /// keyframe at or before it.
+  double landing(double seconds) {
+    if (seeksExactly) return seconds;
+    final index = keyframeIndex;
+    if (index == null || index.isEmpty) return seconds;
+    return index.keyframeBefore(seconds) ?? seconds;
+  }
+
+  /// Drops every waiting request; their futures resolve with `null`.
+  void cancel() {
+    _generation++;
+    _cancelRefine();
+    _pendingTimer?.cancel();
+    _pendingTimer = null;
+    _pendingTarget = null;
+    _supersede();
+  }
+
+  Future<double?> _schedule(double target) {
+    _supersede();
+    final completer = Completer<double?>();
+    final wait = _sinceIssue.isRunning
+        ? minInterval - _sinceIssue.elapsed
+        : Duration.zero;
+    if (wait <= Duration.zero && _pendingTimer == null) {
+      _fire(target, completer);
+      return completer.future;
+    }
+    _pendingTarget = target;
+    _pendingCompleter = completer;
+    _pendingTimer ??= Timer(wait, () {
+      _pendingTimer = null;
+      final target = _pendingTarget;
+      final completer = _pendingCompleter;
+      _pendingTarget = null;
+      _pendingCompleter = null;
+      if (target != null && completer != null) _fire(target, completer);
+    });
+    return completer.future;
+  }
+
+  void _fire(double target, Completer<double?> completer) {
+    _sinceIssue
+      ..reset()
+      ..start();
+    _issued++;
+    try {
+      _issue(target);
+      completer.complete(target);
+    } catch (e, st) {
+      completer.completeError(e, st);
+    }
+  }
+
+  void _supersede() {
+    final previous = _pendingCompleter;
+    _pendingCompleter = null;
+    if (previous != null && !previous.isCompleted) {
+      _superseded++;
+      previous.complete(null);
+    }
+  }
+
+  void _cancelRefine() {
+    _refineTimer?.cancel();
+    _refineTimer = null;
+    final refined = _refineCompleter;
+    _refineCompleter = null;
+    if (refined != null && !refined.isCompleted) {
+      _superseded++;
+      refined.complete(null);
+    }
+  }
+}
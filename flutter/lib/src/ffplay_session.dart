@@ -19,6 +19,7 @@ library;
 import 'dart:async';
 import 'dart:developer';
 import 'dart:ffi';
+import 'dart:io';
 
 import 'package:ffi/ffi.dart';
 
@@ -44,23 +45,19 @@ class FFplaySession extends Session {
 
   int _timeout;
 
-  StreamController<double> _positionController =
-      StreamController<double>.broadcast();
-  Timer? _positionTimer;
-  Timer? _positionSyncTimer;
-  double _syncedPos = 0.0;
-  double _cachedDuration = 0.0;
-  bool _locallyPlaying = false;
-  final Stopwatch _positionStopwatch = Stopwatch();
+  late StreamController<double> _positionController = _newPositionController();
 
-  // Set by seek() so the sync timer knows the next backwards move is
-  // intentional and should be accepted rather than treated as jitter.
-  bool _seekPending = false;
+  // Single emit timer for [positionStream]; runs only while playback is
+  // active and the stream has listeners.  Every [_positionSyncMs] it also
+  // corrects [_clock] from the native player.
+  Timer? _positionTimer;
+  bool _positionActive = false;
+  int _positionSyncMs = 200;
+  int _lastSyncMs = 0;
 
-  // High-water mark for emitted positions — prevents apparent backwards
-  // motion when the sync timer reanchors _syncedPos to a value that the
-  // clamp had previously hidden from the output.  Reset on seek and stream start.
-  double _lastEmittedPos = 0.0;
+  // Interpolated media clock.  Holds the seek-pending flag, EOF freeze, and
+  // high-water mark that keep emitted positions from jittering backwards.
+  final PlaybackClock _clock = PlaybackClock();
 
   // Last known valid volume (0.0–1.0).  Seeded to 1.0 because FFplay's
   // default startup_volume is 100 %.  Updated on every successful native
@@ -76,13 +73,38 @@ class FFplaySession extends Session {
   int _currentEmitMs = _emitMinMs;
   int _lateCount = 0;
   int _onTimeCount = 0;
-  // Separate stopwatch for emit lateness measurement so it is not disturbed
-  // by the sync timer resetting _positionStopwatch.
+  // Measures emit lateness and schedules native syncs on the emit timer.
   final Stopwatch _emitStopwatch = Stopwatch();
+  final Stopwatch _syncStopwatch = Stopwatch();
+
+  late StreamController<FFplayEvent> _eventController = _newEventController();
+
+  // Single status poll behind [events]; runs only while playback is active
+  // and the stream has listeners.
+  Timer? _eventTimer;
+  bool _eventsActive = false;
+  int _eventPollMs = 250;
+  FFplayEventTracker _eventTracker = FFplayEventTracker();
+
+  FFplayPreparedMedia? _prepared;
+
+  late final FFplaySeekScheduler _seekScheduler = FFplaySeekScheduler(seek);
+  bool _keyframeIndexRequested = false;
+
+  // Low-power state.  While idle no timer runs; [_settleSamples] keeps the
+  // polls running after pause, resume, seek, or show until the player
+  // reports the expected state, so no transition is missed.
+  static const int _settleLimit = 20;
+  bool _hidden = false;
+  bool _observedPaused = false;
+  bool _expectPaused = false;
+  int _settleSamples = 0;
+  int _wakeups = 0;
 
-  StreamController<(int, int)> _videoSizeController =
-      StreamController<(int, int)>.broadcast();
-  Timer? _videoSizeTimer;
+  FFplayAudioTap? _audioTap;
+  StreamSubscription<FFplayEvent>? _audioTapEvents;
+
+  FFplayLatencyMonitor? _latencyMonitor;
 
   // ---------------------------------------------------------------------------
   // Constructors
@@ -154,6 +176,56 @@ class FFplaySession extends Session {
     _registered = true;
   }
 
+  /// Creates a new [FFplaySession] from an argument list.
+  ///
+  /// Unlike [FFplaySession.new], the arguments are passed to FFplay as they
+  /// are, so they may contain quotes, backslashes, or spaces.
+  FFplaySession.fromArguments(
+    List<String> arguments, {
+    FFplaySessionCompleteCallback? completeCallback,
+    int timeout = 500,
+  }) : _timeout = timeout {
+    FFmpegKitExtended.requireInitialized();
+    final argv = calloc<Pointer<Char>>(arguments.length);
+    final nativeStrings = <Pointer<Utf8>>[];
+    try {
+      for (var i = 0; i < arguments.length; i++) {
+        final nativeString = arguments[i].toNativeUtf8(allocator: calloc);
+        nativeStrings.add(nativeString);
+        argv[i] = nativeString.cast<Char>();
+      }
+      try {
+        handle = ffmpeg.ffplay_kit_create_session_from_argv(
+          arguments.length,
+          argv,
+        );
+      } catch (e, st) {
+        log(
+          'FFplaySession: error in native function ffplay_kit_create_session_from_argv',
+          error: e,
+          stackTrace: st,
+        );
+        rethrow;
+      }
+      if (handle == nullptr) {
+        throw StateError('Failed to create FFplay session from arguments.');
+      }
+      command = FFmpegKitExtended.argumentsToString(arguments);
+      sessionId = FFmpegKitExtended.getSessionId(handle);
+      registerFinalizer();
+    } finally {
+      for (final nativeString in nativeStrings) {
+        calloc.free(nativeString);
+      }
+      calloc.free(argv);
+    }
+
+    _completeCallback = completeCallback;
+
+    CallbackManager().registerFFplaySession(this);
+    _registered = true;
+  }
+
   // ---------------------------------------------------------------------------
   // Static helpers (deprecated wrappers for API compatibility)
   // ---------------------------------------------------------------------------
@@ -183,6 +255,17 @@ class FFplaySession extends Session {
     completeCallback: completeCallback,
   );
 
+  /// Internal factory used by [FFplayKit] — not part of the public API.
+  static FFplaySession createGlobalFromArguments(
+    List<String> arguments, {
+    FFplaySessionCompleteCallback? completeCallback,
+    int timeout = 500,
+  }) => FFplaySession.fromArguments(
+    arguments,
+    timeout: timeout,
+    completeCallback: completeCallback,
+  );
+
   // ---------------------------------------------------------------------------
   // Callback accessors / mutators
   // ---------------------------------------------------------------------------
@@ -277,8 +360,7 @@ class FFplaySession extends Session {
       rethrow;
     }
     try {
-      final pausePos = ffmpeg.ffplay_kit_session_get_position(handle);
-      _syncedPos = pausePos.isNaN ? _lastEmittedPos : pausePos;
+      _clock.pause(ffmpeg.ffplay_kit_session_get_position(handle));
     } catch (e, st) {
       log(
         'FFplaySession: error in native function ffplay_kit_session_get_position',
@@ -287,8 +369,7 @@ class FFplaySession extends Session {
       );
       rethrow;
     }
-    _positionStopwatch.reset();
-    _locallyPlaying = false;
+    _settle(paused: true);
   }
 
   /// Resumes paused playback.
@@ -305,8 +386,7 @@ class FFplaySession extends Session {
       rethrow;
     }
     try {
-      final resumePos = ffmpeg.ffplay_kit_session_get_position(handle);
-      _syncedPos = resumePos.isNaN ? _lastEmittedPos : resumePos;
+      _clock.resume(ffmpeg.ffplay_kit_session_get_position(handle));
     } catch (e, st) {
       log(
         'FFplaySession: error in native function ffplay_kit_session_get_position',
@@ -315,8 +395,8 @@ class FFplaySession extends Session {
       );
       rethrow;
     }
-    _positionStopwatch.reset();
-    _locallyPlaying = true;
+    _observedPaused = false;
+    _settle(paused: false);
   }
 
   /// Stops playback.
@@ -370,17 +450,239 @@ class FFplaySession extends Session {
       );
       rethrow;
     }
-    // Optimistically update local position so interpolation restarts from the
-    // seek target immediately, before the next native sync fires.
-    _syncedPos = seconds.clamp(
-      0.0,
-      _cachedDuration > 0 ? _cachedDuration : seconds,
+    // Optimistically move the clock so interpolation restarts from the seek
+    // target immediately; the next native sync may then move it backwards.
+    _clock.seek(seconds);
+    _eventTracker.seekIssued(seconds);
+    _settle(paused: _expectPaused || _observedPaused);
+  }
+
+  // ---------------------------------------------------------------------------
+  // Low-power state
+  // ---------------------------------------------------------------------------
+
+  /// Whether the session is idle: paused or hidden, with no timer running.
+  ///
+  /// While idle [positionStream] and [events] stay open but nothing is
+  /// polled.  [resume], [seek], and [setVisible] wake the session, and its
+  /// first poll reports every change that happened meanwhile.  A pause made
+  /// outside this session's API is noticed by the next poll, after which the
+  /// session goes idle; a resume made outside it is noticed on the next wake.
+  bool get isIdle => _hidden || (_observedPaused && _settleSamples == 0);
+
+  /// Whether the view showing this session is visible.
+  bool get isVisible => !_hidden;
+
+  /// Number of timer callbacks this session has run for [positionStream]
+  /// and [events].  Stays constant while the session is idle.
+  int get wakeupCount => _wakeups;
+
+  /// Suspends all polling while the view showing this session is hidden,
+  /// e.g. behind another route or with the app in the background.
+  ///
+  /// Pair it with [FFplaySurface.setFrameDeliveryEnabled] to stop frame
+  /// delivery as well; `FFplayView` does both when given a session.
+  void setVisible(bool visible) {
+    if (_hidden == !visible) return;
+    _hidden = !visible;
+    if (visible) {
+      _settle(paused: _expectPaused || _observedPaused);
+    } else {
+      _applyIdle();
+    }
+  }
+
+  /// Keeps polling until the player reports [paused] (or for at most
+  /// [_settleLimit] samples), then applies the idle state.
+  void _settle({required bool paused}) {
+    _expectPaused = paused;
+    _settleSamples = _settleLimit;
+    _applyIdle();
+  }
+
+  /// Records a polled pause state and counts down [_settleSamples].
+  void _observePaused(bool paused) {
+    _observedPaused = paused;
+    if (_settleSamples == 0) return;
+    final settled = paused == _expectPaused && !_clock.isSeekPending;
+    _settleSamples = settled ? 0 : _settleSamples - 1;
+  }
+
+  /// Cancels every timer while idle, or restarts those with listeners.
+  void _applyIdle() {
+    if (isIdle) {
+      _cancelPositionTick();
+      _cancelEventPoll();
+      return;
+    }
+    if (_positionController.hasListener) _schedulePositionTick();
+    if (_eventController.hasListener) _startEventPoll(fresh: false);
+  }
+
+  // ---------------------------------------------------------------------------
+  // Preparation
+  // ---------------------------------------------------------------------------
+
+  /// The result of [prepare], or `null` if it has not completed.
+  FFplayPreparedMedia? get prepared => _prepared;
+
+  /// Probes, indexes, and warms this session's input through
+  /// [FFplayKit.preparePool] so that [executeAsync] only pays for decoder
+  /// start-up.
+  ///
+  /// The prepared duration seeds [clock] until the native player reports
+  /// its own.  Resolves with `null` if the command names no input.
+  Future<FFplayPreparedMedia?> prepare() async {
+    final input = FFplayPreparePool.inputOf(command);
+    if (input == null) return null;
+    final prepared = await FFplayKit.preparePool.prepare(input);
+    _prepared = prepared;
+    _seekScheduler.keyframeIndex ??= prepared.keyframeIndex;
+    if (_clock.duration <= 0.0) _clock.duration = prepared.duration;
+    return prepared;
+  }
+
+  /// Seeks to [seconds] using [mode], coalescing bursts of requests.
+  ///
+  /// Unlike [seek], which issues every call, requests are paced by an
+  /// [FFplaySeekScheduler]: at most one seek reaches the player every 33 ms
+  /// and a newer request replaces one still waiting.  Keyframe snapping uses
+  /// the index from [prepare], or builds one in the background for local
+  /// files; until it is available keyframe seeks behave as accurate seeks.
+  ///
+  /// Resolves with the position issued for this request, or `null` if a
+  /// newer request superseded it.
+  Future<double?> seekTo(
+    double seconds, {
+    FFplaySeekMode mode = FFplaySeekMode.accurate,
+  }) {
+    if (mode != FFplaySeekMode.accurate) _ensureKeyframeIndex();
+    return _seekScheduler.request(seconds, mode);
+  }
+
+  /// The scheduler behind [seekTo].
+  FFplaySeekScheduler get seekScheduler => _seekScheduler;
+
+  void _ensureKeyframeIndex() {
+    if (_seekScheduler.keyframeIndex != null || _keyframeIndexRequested) {
+      return;
+    }
+    _keyframeIndexRequested = true;
+    final prepared = _prepared?.keyframeIndex;
+    if (prepared != null) {
+      _seekScheduler.keyframeIndex = prepared;
+      return;
+    }
+    final input = FFplayPreparePool.inputOf(command);
+    if (input == null || !File(input).existsSync()) return;
+    FFprobeKit.getKeyframeIndex(input).then(
+      (index) => _seekScheduler.keyframeIndex = index,
+      onError: (Object e, StackTrace st) {
+        log(
+          'FFplaySession: error building keyframe index for $input',
+          error: e,
+          stackTrace: st,
+        );
+      },
+    );
+  }
+
+  // ---------------------------------------------------------------------------
+  // Audio tap
+  // ---------------------------------------------------------------------------
+
+  /// The tap added by [addAudioTap], or `null`.
+  FFplayAudioTap? get audioTap => _audioTap;
+
+  /// Taps the audio of this session's input as interleaved float PCM.
+  ///
+  /// The tap follows playback through [events]: it starts at the current
+  /// position when playback runs, stops while paused, restarts at the new
+  /// position once seeking settles, and closes when the session ends.
+  /// Replaces any previous tap.  The tap decodes the input a second time;
+  /// see [FFplayAudioTap] for what that implies.
+  ///
+  /// Throws [StateError] if the command names no input, or names one that
+  /// cannot be opened twice ([FFplayAudioTap.supportsInput]).
+  FFplayAudioTap addAudioTap({
+    int sampleRate = 48000,
+    int channels = 2,
+    int blockFrames = 1024,
+    int decimation = 1,
+    Duration history = const Duration(seconds: 2),
+  }) {
+    final input = FFplayPreparePool.inputOf(command);
+    if (input == null) {
+      throw StateError('FFplaySession: command names no input to tap');
+    }
+    if (!FFplayAudioTap.supportsInput(input)) {
+      throw StateError('FFplaySession: $input cannot be opened twice to tap');
+    }
+    removeAudioTap();
+    final tap = FFplayAudioTap(
+      input,
+      sampleRate: sampleRate,
+      channels: channels,
+      blockFrames: blockFrames,
+      decimation: decimation,
+      history: history,
+    );
+    _audioTap = tap;
+    var playing = false;
+    _audioTapEvents = events.listen(
+      (event) {
+        switch (event) {
+          case FFplayStateChanged(:final state):
+            final nowPlaying = state == FFplayPlaybackState.playing;
+            if (nowPlaying && !playing) tap.start(_clock.position);
+            if (!nowPlaying) tap.stop();
+            playing = nowPlaying;
+          case FFplaySeekComplete(:final position):
+            if (playing) tap.seekTo(position);
+          default:
+            break;
+        }
+      },
+      onDone: () {
+        if (identical(_audioTap, tap)) removeAudioTap();
+      },
+    );
+    return tap;
+  }
+
+  /// Stops and closes the tap added by [addAudioTap].
+  void removeAudioTap() {
+    _audioTapEvents?.cancel();
+    _audioTapEvents = null;
+    _audioTap?.close();
+    _audioTap = null;
+  }
+
+  // ---------------------------------------------------------------------------
+  // Live latency
+  // ---------------------------------------------------------------------------
+
+  /// The monitor created by [monitorLatency], or `null`.
+  FFplayLatencyMonitor? get latencyMonitor => _latencyMonitor;
+
+  /// Measures the end-to-end latency of this live session.
+  ///
+  /// [reference] maps the displayed position to the time the content was
+  /// captured; see [FFplayLiveReference].  The monitor samples the native
+  /// position only while its stream has listeners, replaces any previous
+  /// monitor, and closes when the session ends.
+  FFplayLatencyMonitor monitorLatency(
+    FFplayLiveReference reference, {
+    Duration interval = const Duration(milliseconds: 500),
+    Duration target = const Duration(milliseconds: 500),
+  }) {
+    _latencyMonitor?.close();
+    return _latencyMonitor = FFplayLatencyMonitor(
+      getPosition,
+      reference,
+      interval: interval,
+      target: target,
     );
-    _lastEmittedPos = _syncedPos;
-    _positionStopwatch.reset();
-    // Allow the next sync tick to accept a lower native value if the seek
-    // target is earlier than the current position.
-    _seekPending = true;
   }
 
   // ---------------------------------------------------------------------------
@@ -642,16 +944,36 @@ class FFplaySession extends Session {
   // Position stream
   // ---------------------------------------------------------------------------
 
-  /// Stream of playback positions in seconds, polled every 200 ms by default.
-  /// Subscribe before calling [executeAsync]. Stream emits positions at
-  /// configured interval and closes automatically when playback ends.
+  /// Stream of playback positions in seconds, interpolated by [clock] and
+  /// corrected from the native player every 200 ms.
+  /// Subscribe before calling [executeAsync]. Nothing runs while the stream
+  /// has no listeners; it closes automatically when playback ends.
   Stream<double> get positionStream => _positionController.stream;
 
-  /// Stream of `(width, height)` video dimension records, polled every 500 ms.
+  /// The interpolated media clock behind [positionStream].
+  ///
+  /// Reading [PlaybackClock.position] makes no native call, so a UI can
+  /// sample it on every frame instead of subscribing to [positionStream].
+  /// The clock is re-anchored on [pause], [resume], and [seek]; it is only
+  /// corrected for buffering stalls while [positionStream] is listened to.
+  PlaybackClock get clock => _clock;
+
+  /// Stream of `(width, height)` video dimension records, derived from
+  /// [events].
   /// Emits new value only when dimensions change (e.g., when first frame
   /// is decoded and video size becomes known). Closes when playback ends.
-  /// Subscribe before calling [executeAsync] to receive initial dimensions.
-  Stream<(int, int)> get videoSizeStream => _videoSizeController.stream;
+  Stream<(int, int)> get videoSizeStream => events
+      .where((e) => e is FFplayVideoSizeChanged)
+      .cast<FFplayVideoSizeChanged>()
+      .map((e) => (e.width, e.height));
+
+  /// Stream of typed player events: video size, playback state, buffering,
+  /// end of file, and seek completion.
+  ///
+  /// Every event comes from one status poll every 250 ms that runs only
+  /// while this stream has listeners.  A first listener receives the current
+  /// size and state straight away.  Closes when playback ends.
+  Stream<FFplayEvent> get events => _eventController.stream;
 
   // ---------------------------------------------------------------------------
   // Private implementation
@@ -674,7 +996,9 @@ class FFplaySession extends Session {
       _closeLogStreams();
       _unregister();
       _stopPositionStream();
-      _stopVideoSizeStream();
+      _stopEventStream();
+      _seekScheduler.cancel();
+      _latencyMonitor?.close();
     };
 
     _enableNativeLogCallback();
@@ -689,7 +1013,7 @@ class FFplaySession extends Session {
       _closeLogStreams();
       _unregister();
       _stopPositionStream();
-      _stopVideoSizeStream();
+      _stopEventStream();
       if (!sessionCompleter.isCompleted) sessionCompleter.complete();
       rethrow;
     }
@@ -706,7 +1030,7 @@ class FFplaySession extends Session {
       _closeLogStreams();
       _unregister();
       _stopPositionStream();
-      _stopVideoSizeStream();
+      _stopEventStream();
       if (!sessionCompleter.isCompleted) sessionCompleter.complete();
       rethrow;
     }
@@ -714,7 +1038,7 @@ class FFplaySession extends Session {
     // Start polling only after the native session is executing so timers never
     // fire against a not-yet-started session during SessionQueueManager delays.
     _startPositionStream();
-    _startVideoSizeStream();
+    _startEventStream();
 
     await sessionCompleter.future;
   }
@@ -789,13 +1113,19 @@ class FFplaySession extends Session {
     }
   }
 
+  StreamController<double> _newPositionController() =>
+      StreamController<double>.broadcast(
+        onListen: _schedulePositionTick,
+        onCancel: _cancelPositionTick,
+      );
+
   /// Starts the position stream.
   ///
-  /// Emits interpolated position at an adaptive rate (starting at ~60 fps,
-  /// backing off toward 10 fps if the event loop is saturated) by advancing a
-  /// local [Stopwatch] since the last native sync.  A separate
-  /// [Timer.periodic] calls the native layer every [syncMs] milliseconds
-  /// (default 200 ms) to correct for drift from buffering stalls or seeks.
+  /// Seeds [_clock] from the native player and, if [positionStream] has
+  /// listeners, starts the emit timer.  The timer emits the clock position
+  /// at an adaptive rate (starting at ~60 fps, backing off toward 10 fps if
+  /// the event loop is saturated) and corrects the clock from the native
+  /// layer every [syncMs] milliseconds (default 200 ms) on the same tick.
   ///
   /// The emit timer is a recursive [Timer] (not [Timer.periodic]) so its
   /// interval can be adjusted without cancelling and recreating from outside.
@@ -804,224 +1134,253 @@ class FFplaySession extends Session {
   /// the interval up by [_emitStepMs]; five consecutive on-time fires step it
   /// back down, with hysteresis to prevent thrashing.
   void _startPositionStream({int syncMs = 200}) {
-    _positionTimer?.cancel();
-    _positionSyncTimer?.cancel();
+    _cancelPositionTick();
     if (_positionController.isClosed) {
-      _positionController = StreamController<double>.broadcast();
+      _positionController = _newPositionController();
     }
+    _positionSyncMs = syncMs;
 
     // Initial ground truth.  Guard NaN in case the native context isn't ready
-    // yet (e.g., called before the first frame is decoded).  A NaN here would
-    // poison _lastEmittedPos and cause ArgumentError inside .clamp() later.
+    // yet (e.g., called before the first frame is decoded).
+    var position = 0.0;
+    var playing = false;
     try {
-      _syncedPos = ffmpeg.ffplay_kit_session_get_position(handle);
+      position = ffmpeg.ffplay_kit_session_get_position(handle);
     } catch (e, st) {
       log(
         'FFplaySession: error getting position ffplay_kit_session_get_position $sessionId',
         error: e,
         stackTrace: st,
       );
-      _syncedPos = 0.0;
-    }
-    if (_syncedPos.isNaN) _syncedPos = 0.0;
-    try {
-      _cachedDuration = ffmpeg.ffplay_kit_session_get_duration(handle);
-    } catch (e, st) {
-      log(
-        'FFplaySession: error getting duration ffplay_kit_session_get_duration $sessionId',
-        error: e,
-        stackTrace: st,
-      );
-      _cachedDuration = 0;
     }
+    _refreshDuration();
     try {
-      _locallyPlaying = ffmpeg.ffplay_kit_session_is_playing(handle);
+      playing = ffmpeg.ffplay_kit_session_is_playing(handle);
     } catch (e, st) {
       log(
         'FFplaySession: error checking playing state ffplay_kit_session_is_playing $sessionId',
         error: e,
         stackTrace: st,
       );
-      _locallyPlaying = false;
     }
-    _lastEmittedPos = _syncedPos;
-    _positionStopwatch
+    _clock.reset(position, running: playing);
+    _observedPaused = false;
+    _settleSamples = 0;
+
+    _positionActive = true;
+    if (_positionController.hasListener) _schedulePositionTick();
+  }
+
+  /// Starts the emit timer if playback is active and nothing is scheduled.
+  void _schedulePositionTick() {
+    if (!_positionActive || _positionTimer != null) return;
+    if (isIdle) {
+      // Nothing moves while idle; one sample serves a new listener.
+      if (!_positionController.isClosed) {
+        _positionController.add(_clock.position);
+      }
+      return;
+    }
+    _emitStopwatch
       ..reset()
       ..start();
-    _emitStopwatch
+    _syncStopwatch
       ..reset()
       ..start();
+    _lastSyncMs = 0;
     _currentEmitMs = _emitMinMs;
     _lateCount = 0;
     _onTimeCount = 0;
+    _syncPosition();
+    _scheduleEmit();
+  }
 
-    // Periodic native sync — corrects drift at low, fixed overhead.
-    _positionSyncTimer = Timer.periodic(Duration(milliseconds: syncMs), (_) {
-      final prevPos = _syncedPos;
-      final prevPlaying = _locallyPlaying;
-      double newPos;
-      bool newPlaying;
-      try {
-        newPos = ffmpeg.ffplay_kit_session_get_position(handle);
-        newPlaying = ffmpeg.ffplay_kit_session_is_playing(handle);
-      } catch (e, st) {
-        log(
-          'FFplaySession: error getting position or playing state ffplay_kit_session_get_position/ffplay_kit_session_is_playing $sessionId',
-          error: e,
-          stackTrace: st,
-        );
-        return;
-      }
+  void _cancelPositionTick() {
+    _positionTimer?.cancel();
+    _positionTimer = null;
+    _emitStopwatch.stop();
+    _syncStopwatch.stop();
+  }
 
-      // Duration is unavailable until the file is opened by the native layer.
-      // Keep retrying until we get a valid value so the Dart clamp activates.
-      if (_cachedDuration <= 0.0 || _cachedDuration.isNaN) {
-        try {
-          _cachedDuration = ffmpeg.ffplay_kit_session_get_duration(handle);
-        } catch (e, st) {
-          log(
-            'FFplaySession: error getting duration ffplay_kit_session_get_duration $sessionId',
-            error: e,
-            stackTrace: st,
+  // Adaptive recursive emit timer.
+  void _scheduleEmit() {
+    _emitStopwatch.reset();
+    _positionTimer = Timer(Duration(milliseconds: _currentEmitMs), () {
+      _positionTimer = null;
+      if (_positionController.isClosed) return;
+      _wakeups++;
+
+      // Measure lateness against _emitStopwatch, which is only reset at the
+      // start of each emit tick.
+      final actualMs = _emitStopwatch.elapsedMilliseconds;
+      final thresholdMs = (_currentEmitMs * 1.5).round();
+
+      if (actualMs > thresholdMs) {
+        _lateCount++;
+        _onTimeCount = 0;
+        if (_lateCount >= 3) {
+          // Event loop is struggling — step down emit rate.
+          _currentEmitMs = (_currentEmitMs + _emitStepMs).clamp(
+            _emitMinMs,
+            _emitMaxMs,
+          );
+          _lateCount = 0;
+        }
+      } else {
+        _onTimeCount++;
+        _lateCount = 0;
+        if (_onTimeCount >= 5 && _currentEmitMs > _emitMinMs) {
+          // Event loop recovered — step back up, with hysteresis.
+          _currentEmitMs = (_currentEmitMs - _emitStepMs).clamp(
+            _emitMinMs,
+            _emitMaxMs,
           );
-          _cachedDuration = 0.0;
+          _onTimeCount = 0;
         }
       }
 
-      // During seek the native clock is undefined; FFplay reports nan.
-      // Skip the entire update to avoid poisoning _syncedPos.
-      if (newPos.isNaN) return;
-
-      _locallyPlaying = newPlaying;
+      final nowMs = _syncStopwatch.elapsedMilliseconds;
+      if (nowMs - _lastSyncMs >= _positionSyncMs) {
+        _lastSyncMs = nowMs;
+        _syncPosition();
+      }
 
-      if (prevPlaying && !newPlaying) {
-        // Playback just ended. The native context may already have reset to 0;
-        // freeze at duration so the UI lands on the final frame, not the start.
-        _syncedPos = _cachedDuration > 0.0 ? _cachedDuration : prevPos;
-      } else if (_seekPending || newPos >= _syncedPos) {
-        // Normal forward progress, or a user seek allows backwards movement.
-        _syncedPos = newPos;
-        _seekPending = false;
+      _positionController.add(_clock.position);
+      if (isIdle) {
+        _applyIdle();
       } else {
-        // Native position went backwards without a seek — clock jitter near
-        // EOF or a buffer stall. Ignore and keep the last good position.
+        _scheduleEmit();
       }
-
-      _positionStopwatch.reset();
     });
+  }
 
-    // Adaptive recursive emit timer.
-    void scheduleEmit() {
-      _emitStopwatch.reset();
-      _positionTimer = Timer(Duration(milliseconds: _currentEmitMs), () {
-        if (_positionController.isClosed) return;
-
-        // Measure lateness against _emitStopwatch, which is independent of
-        // the sync timer and only reset at the start of each emit tick.
-        final actualMs = _emitStopwatch.elapsedMilliseconds;
-        final thresholdMs = (_currentEmitMs * 1.5).round();
+  /// Corrects [_clock] from the native player.
+  void _syncPosition() {
+    double position;
+    bool playing;
+    bool paused;
+    try {
+      position = ffmpeg.ffplay_kit_session_get_position(handle);
+      playing = ffmpeg.ffplay_kit_session_is_playing(handle);
+      paused = ffmpeg.ffplay_kit_session_is_paused(handle);
+    } catch (e, st) {
+      log(
+        'FFplaySession: error getting position or playing state ffplay_kit_session_get_position/ffplay_kit_session_is_playing $sessionId',
+        error: e,
+        stackTrace: st,
+      );
+      return;
+    }
+    // Duration is unavailable until the file is opened by the native layer.
+    // Keep retrying until we get a valid value so the clock cap activates.
+    if (_clock.duration <= 0.0) _refreshDuration();
+    _clock.sync(position, playing);
+    _observePaused(paused);
+  }
 
-        if (actualMs > thresholdMs) {
-          _lateCount++;
-          _onTimeCount = 0;
-          if (_lateCount >= 3) {
-            // Event loop is struggling — step down emit rate.
-            _currentEmitMs = (_currentEmitMs + _emitStepMs).clamp(
-              _emitMinMs,
-              _emitMaxMs,
-            );
-            _lateCount = 0;
-          }
-        } else {
-          _onTimeCount++;
-          _lateCount = 0;
-          if (_onTimeCount >= 5 && _currentEmitMs > _emitMinMs) {
-            // Event loop recovered — step back up, with hysteresis.
-            _currentEmitMs = (_currentEmitMs - _emitStepMs).clamp(
-              _emitMinMs,
-              _emitMaxMs,
-            );
-            _onTimeCount = 0;
-          }
-        }
+  void _refreshDuration() {
+    try {
+      final duration = ffmpeg.ffplay_kit_session_get_duration(handle);
+      if (duration > 0.0) _clock.duration = duration;
+    } catch (e, st) {
+      log(
+        'FFplaySession: error getting duration ffplay_kit_session_get_duration $sessionId',
+        error: e,
+        stackTrace: st,
+      );
+    }
+  }
 
-        // Interpolate position locally between native syncs.
-        final rawPos =
-            _syncedPos +
-            (_locallyPlaying
-                ? _positionStopwatch.elapsed.inMicroseconds / 1e6
-                : 0.0);
-        // Skip emit if rawPos is NaN (defensive guard — sync timer normally
-        // catches nan from the native layer, but guard here as a safety net).
-        if (rawPos.isNaN) {
-          scheduleEmit();
-          return;
-        }
-        final clamped = _cachedDuration > 0.0 && rawPos > _cachedDuration;
-        // Apply high-water mark: never emit a value lower than what was
-        // previously emitted.  This prevents apparent backwards jitter when
-        // the sync timer reanchors _syncedPos to a native value that the
-        // duration clamp had already masked from the output.
-        final pos = (clamped ? _cachedDuration : rawPos).clamp(
-          _lastEmittedPos,
-          double.infinity,
-        );
-        _lastEmittedPos = pos;
+  /// Cancels the emit timer and closes [positionStream].
+  void _stopPositionStream() {
+    _positionActive = false;
+    _cancelPositionTick();
+    if (!_positionController.isClosed) _positionController.close();
+  }
 
-        _positionController.add(pos);
+  StreamController<FFplayEvent> _newEventController() =>
+      StreamController<FFplayEvent>.broadcast(
+        onListen: _scheduleEventPoll,
+        onCancel: _cancelEventPoll,
+      );
 
-        scheduleEmit();
-      });
+  /// Starts the event stream; polling begins once [events] has listeners.
+  void _startEventStream({int intervalMs = 250}) {
+    _cancelEventPoll();
+    if (_eventController.isClosed) {
+      _eventController = _newEventController();
     }
+    _eventPollMs = intervalMs;
+    _eventsActive = true;
+    if (_eventController.hasListener) _scheduleEventPoll();
+  }
 
-    scheduleEmit();
+  void _scheduleEventPoll() => _startEventPoll(fresh: true);
+
+  /// Starts the status poll.  A [fresh] tracker makes the first sample report
+  /// the current size and state to listeners that subscribed while polling
+  /// was stopped; waking from idle keeps the tracker so that only changes
+  /// made while idle are reported.
+  void _startEventPoll({required bool fresh}) {
+    if (!_eventsActive || _eventTimer != null) return;
+    if (fresh) {
+      _eventTracker = FFplayEventTracker();
+      if (_clock.isSeekPending) _eventTracker.seekIssued(_clock.position);
+    }
+    _pollEvents();
+    // While idle the one sample above is all a new listener needs.
+    if (isIdle) return;
+    _eventTimer = Timer.periodic(Duration(milliseconds: _eventPollMs), (_) {
+      _wakeups++;
+      _pollEvents();
+      if (isIdle) _applyIdle();
+    });
   }
 
-  /// Cancels both timers and closes [positionStream].
-  void _stopPositionStream() {
-    _positionTimer?.cancel();
-    _positionTimer = null;
-    _positionSyncTimer?.cancel();
-    _positionSyncTimer = null;
-    _positionStopwatch.stop();
-    _emitStopwatch.stop();
-    if (!_positionController.isClosed) _positionController.close();
+  void _cancelEventPoll() {
+    _eventTimer?.cancel();
+    _eventTimer = null;
   }
 
-  /// Starts polling [getVideoWidth]/[getVideoHeight] every 500 ms and pushes
-  /// `(width, height)` onto [videoSizeStream] whenever dimensions change.
-  void _startVideoSizeStream({int intervalMs = 500}) {
-    _videoSizeTimer?.cancel();
-    if (_videoSizeController.isClosed) {
-      _videoSizeController = StreamController<(int, int)>.broadcast();
+  /// Samples every observable native property once and emits the changes.
+  void _pollEvents() {
+    FFplayStatus status;
+    try {
+      status = FFplayStatus(
+        width: ffmpeg.ffplay_kit_session_get_video_width(handle),
+        height: ffmpeg.ffplay_kit_session_get_video_height(handle),
+        playing: ffmpeg.ffplay_kit_session_is_playing(handle),
+        paused: ffmpeg.ffplay_kit_session_is_paused(handle),
+        position: ffmpeg.ffplay_kit_session_get_position(handle),
+      );
+    } catch (e, st) {
+      log(
+        'FFplaySession: error polling player status $sessionId',
+        error: e,
+        stackTrace: st,
+      );
+      return;
+    }
+    // The sample is as fresh as a position sync, so keep the clock with it.
+    _clock.sync(status.position, status.playing);
+    _observePaused(status.paused);
+    for (final event in _eventTracker.update(status)) {
+      if (_eventController.isClosed) return;
+      _eventController.add(event);
     }
-    int lastW = 0, lastH = 0;
-    _videoSizeTimer = Timer.periodic(Duration(milliseconds: intervalMs), (_) {
-      int w;
-      int h;
-      try {
-        w = ffmpeg.ffplay_kit_session_get_video_width(handle);
-        h = ffmpeg.ffplay_kit_session_get_video_height(handle);
-      } catch (e, st) {
-        log(
-          'FFplaySession: error getting video width or height ffplay_kit_session_get_video_width/ffplay_kit_session_get_video_height $sessionId',
-          error: e,
-          stackTrace: st,
-        );
-        return;
-      }
-      if ((w != lastW || h != lastH) && w > 0 && h > 0) {
-        lastW = w;
-        lastH = h;
-        if (!_videoSizeController.isClosed) _videoSizeController.add((w, h));
-      }
-    });
   }
 
-  /// Cancels video-size polling timer and closes [videoSizeStream].
-  void _stopVideoSizeStream() {
-    _videoSizeTimer?.cancel();
-    _videoSizeTimer = null;
-    if (!_videoSizeController.isClosed) _videoSizeController.close();
+  /// Cancels the status poll, reports the final state, and closes [events].
+  void _stopEventStream() {
+    _eventsActive = false;
+    _cancelEventPoll();
+    if (_eventController.isClosed) return;
+    final state = _eventTracker.state;
+    if (state != null && state != FFplayPlaybackState.stopped) {
+      _eventController.add(
+        const FFplayStateChanged(FFplayPlaybackState.stopped),
+      );
+    }
+    _eventController.close();
   }
 }
@@ -105,6 +105,13 @@ class FFplaySurface {
   /// Uses ValueKey to force widget recreation when textureId changes.
   Widget toWidget() => Texture(key: ValueKey(textureId), textureId: textureId);
 
+  /// Stops or restarts frame delivery while the view is hidden.
+  ///
+  /// A no-op where the platform has no way to pause delivery.
+  Future<void> setFrameDeliveryEnabled(bool enabled) async {
+    await _desktop?.setFrameDeliveryEnabled(enabled);
+  }
+
   /// Releases native resources and stops frame delivery.
   /// After calling this, discard the [FFplaySurface] instance.
   Future<void> release() async {
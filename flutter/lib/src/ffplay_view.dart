@@ -22,6 +22,7 @@ import 'dart:math' show min;
 import 'package:flutter/material.dart';
 import 'package:flutter/services.dart';
 
+import 'ffplay_session.dart';
 import 'ffplay_surface.dart';
 
 /// Controls the fullscreen state of an [FFplayView].
@@ -130,9 +131,19 @@ class FFplayViewController extends ChangeNotifier {
 /// For true OS-level fullscreen on Windows / Linux supply
 /// [FFplayViewController.onEnterFullscreen] /
 /// [FFplayViewController.onExitFullscreen].
+///
+/// ### Low-power state
+///
+/// When [session] is given, the view suspends it while the view cannot be
+/// seen — the app is hidden or in the background, or the view sits on a
+/// route or tab whose tickers are disabled.  Polling stops through
+/// [FFplaySession.setVisible] and frame delivery through
+/// [FFplaySurface.setFrameDeliveryEnabled]; both resume when the view is
+/// shown again.
 class FFplayView extends StatefulWidget {
   const FFplayView({
     required this.surface,
+    this.session,
     this.controller,
     this.aspectRatio,
     this.videoWidth,
@@ -144,6 +155,10 @@ class FFplayView extends StatefulWidget {
   /// The video surface to display.
   final FFplaySurface surface;
 
+  /// The session rendering into [surface], suspended while the view is
+  /// hidden.  When omitted the view never changes the session's state.
+  final FFplaySession? session;
+
   /// Controls fullscreen state.  When omitted no fullscreen capability is
   /// wired up (useful when the consumer handles navigation manually).
   final FFplayViewController? controller;
@@ -165,16 +180,35 @@ class FFplayView extends StatefulWidget {
   State<FFplayView> createState() => _FFplayViewState();
 }
 
-class _FFplayViewState extends State<FFplayView> {
+class _FFplayViewState extends State<FFplayView> with WidgetsBindingObserver {
   static bool get _isMobile => Platform.isAndroid || Platform.isIOS;
 
   /// Stored while a fullscreen route is active; used by [_popFullscreen].
   NavigatorState? _fullscreenNav;
 
+  bool _appVisible = true;
+  bool _tickersEnabled = true;
+  bool? _reportedVisible; // last visibility passed to the session
+
   @override
   void initState() {
     super.initState();
     _attachController(widget.controller);
+    WidgetsBinding.instance.addObserver(this);
+    _appVisible = _isAppVisible(WidgetsBinding.instance.lifecycleState);
+  }
+
+  @override
+  void didChangeDependencies() {
+    super.didChangeDependencies();
+    _tickersEnabled = TickerMode.of(context);
+    _updateVisibility();
+  }
+
+  @override
+  void didChangeAppLifecycleState(AppLifecycleState state) {
+    _appVisible = _isAppVisible(state);
+    _updateVisibility();
   }
 
   @override
@@ -184,14 +218,45 @@ class _FFplayViewState extends State<FFplayView> {
       old.controller?._detach();
       _attachController(widget.controller);
     }
+    if (old.session != widget.session || old.surface != widget.surface) {
+      _showSession(old.session, old.surface);
+      _reportedVisible = null;
+      _updateVisibility();
+    }
   }
 
   @override
   void dispose() {
     widget.controller?._detach();
+    WidgetsBinding.instance.removeObserver(this);
+    // Never leave a session suspended by a view that no longer exists.
+    _showSession(widget.session, widget.surface);
     super.dispose();
   }
 
+  static bool _isAppVisible(AppLifecycleState? state) =>
+      state == null ||
+      state == AppLifecycleState.resumed ||
+      state == AppLifecycleState.inactive;
+
+  void _updateVisibility() {
+    final session = widget.session;
+    if (session == null) return;
+    // The fullscreen route shows the same surface, so the view stays
+    // visible while its own route is covered by it.
+    final visible = _fullscreenNav != null || (_appVisible && _tickersEnabled);
+    if (visible == _reportedVisible) return;
+    _reportedVisible = visible;
+    session.setVisible(visible);
+    widget.surface.setFrameDeliveryEnabled(visible);
+  }
+
+  void _showSession(FFplaySession? session, FFplaySurface surface) {
+    if (session == null || _reportedVisible != false) return;
+    session.setVisible(true);
+    surface.setFrameDeliveryEnabled(true);
+  }
+
   void _attachController(FFplayViewController? controller) {
     controller?._attach(enter: _enterFullscreen, exit: _popFullscreen);
   }
@@ -210,6 +275,7 @@ class _FFplayViewState extends State<FFplayView> {
     widget.controller?._setIsFullscreen(true);
 
     _fullscreenNav = navigator;
+    _updateVisibility();
     await _fullscreenNav!.push(
       MaterialPageRoute<void>(
         fullscreenDialog: true,
@@ -225,6 +291,7 @@ class _FFplayViewState extends State<FFplayView> {
     _fullscreenNav = null;
 
     if (!mounted) return;
+    _updateVisibility();
     if (_isMobile) {
       await SystemChrome.setEnabledSystemUIMode(SystemUiMode.edgeToEdge);
     }
@@ -36,6 +36,57 @@ class FFprobeKit {
               onComplete: onComplete)
           .executeAsync();
 
+  /// Probes [path] for only the requested [fields].
+  ///
+  /// Much cheaper than [getMediaInformationAsync] when only a few fields such
+  /// as duration or dimensions are needed; see [FastProbe].
+  static Future<ProbeResult> probe(String path,
+          {Set<ProbeField> fields = FastProbe.defaultFields,
+          int? probeSize,
+          Duration? analyzeDuration}) =>
+      FastProbe.probe(path,
+          fields: fields,
+          probeSize: probeSize,
+          analyzeDuration: analyzeDuration);
+
+  /// Probes every path in [paths] and emits results as they complete.
+  ///
+  /// Runs on a dedicated [MediaProbePool] of [concurrency] background isolates
+  /// (sized by [MediaProbePool.defaultConcurrency] when omitted) instead of
+  /// one [MediaInformationSession] per file.  Per-file failures are emitted
+  /// as [ProbeException] errors without aborting the batch.
+  static Stream<MediaInformation> probeAll(Iterable<String> paths,
+      {int? concurrency, int? probeSize, Duration? analyzeDuration}) {
+    final list = paths is List<String> ? paths : paths.toList();
+    final pool = MediaProbePool(
+        concurrency: concurrency ?? MediaProbePool.defaultConcurrency(list),
+        probeSize: probeSize,
+        analyzeDuration: analyzeDuration);
+    return pool.probeAll(list, closePoolWhenDone: true);
+  }
+
+  /// Cache consulted by [getCachedMediaInformation].
+  ///
+  /// In-memory only by default; assign a cache with a `storePath` to persist
+  /// entries across restarts.
+  static MediaInformationCache mediaInformationCache = MediaInformationCache();
+
+  /// Retrieves media information for [path], probing only if the file is not
+  /// in [mediaInformationCache] or has changed since it was cached.
+  static Future<MediaInformation?> getCachedMediaInformation(String path) =>
+      mediaInformationCache.getMediaInformation(path);
+
+  /// Cache consulted by [getKeyframeIndex].
+  ///
+  /// In-memory only by default; assign a cache with a `directory` (for
+  /// example next to the media information store) to persist indexes.
+  static KeyframeIndexCache keyframeIndexCache = KeyframeIndexCache();
+
+  /// Returns the keyframe index of the first video stream of [path], building
+  /// it with one demux-only pass if it is not in [keyframeIndexCache].
+  static Future<KeyframeIndex> getKeyframeIndex(String path) =>
+      keyframeIndexCache.getIndex(path);
+
   /// Executes an FFprobe [command] synchronously.
   static FFprobeSession execute(String command) =>
       FFprobeSession.executeCommand(command);
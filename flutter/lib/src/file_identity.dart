@@ -0,0 +1,44 @@
+/*
+ * FFmpegKit Flutter Extended Plugin - A wrapper library for FFmpeg
+ * Copyright (C) 2026 Akash Patel
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+import 'dart:io';
+
+import 'package:crypto/crypto.dart';
+
+/// Returns a string that changes whenever the local file at [path] changes.
+///
+/// By default this is the absolute path, size, and modification time, which
+/// only needs a `stat`.  With [hashContent] it is a SHA-256 of the content,
+/// which survives moves and copies at the cost of reading the whole file.
+/// Returns `null` if [path] is not an existing local file (e.g. a URL).
+Future<String?> fileIdentity(String path, {bool hashContent = false}) async {
+  final file = File(path);
+  final FileStat stat;
+  try {
+    stat = await file.stat();
+  } on FileSystemException {
+    return null;
+  }
+  if (stat.type != FileSystemEntityType.file) return null;
+  if (hashContent) {
+    return 'sha256:${await sha256.bind(file.openRead()).first}';
+  }
+  return '${file.absolute.path}|${stat.size}|'
+      '${stat.modified.microsecondsSinceEpoch}';
+}
@@ -0,0 +1,262 @@
+/*
+ * FFmpegKit Flutter Extended Plugin - A wrapper library for FFmpeg
+ * Copyright (C) 2026 Akash Patel
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+import 'dart:async';
+import 'dart:developer';
+import 'dart:io';
+import 'dart:typed_data';
+
+import 'package:path/path.dart' as p;
+
+import 'callback_manager.dart';
+import 'ffmpeg_session.dart';
+import 'session.dart';
+
+/// A single still image to be processed by an [ImageBatchWorker].
+class ImageBatchItem {
+  /// Source image path, or `null` when [bytes] is used.
+  final String? input;
+
+  /// Encoded source image, or `null` when [input] is used.
+  final Uint8List? bytes;
+
+  /// Destination path; its extension selects the output format.
+  final String output;
+
+  /// Creates an item that reads [input] and writes [output].
+  const ImageBatchItem(String this.input, this.output) : bytes = null;
+
+  /// Creates an item from an encoded image held in memory.
+  const ImageBatchItem.bytes(Uint8List this.bytes, this.output)
+    : input = null;
+}
+
+/// Outcome of a single [ImageBatchItem].
+class ImageBatchResult {
+  /// The processed item.
+  final ImageBatchItem item;
+
+  /// Whether [ImageBatchItem.output] was written.
+  final bool isSuccess;
+
+  /// Encoded output, when [ImageBatchWorker.readOutputBytes] is set.
+  final Uint8List? outputBytes;
+
+  /// FFmpeg log output of the session that processed this item on failure.
+  final String? error;
+
+  const ImageBatchResult._(
+    this.item,
+    this.isSuccess, {
+    this.outputBytes,
+    this.error,
+  });
+
+  @override
+  String toString() =>
+      'ImageBatchResult(${item.input ?? '<bytes>'} -> ${item.output}, success: $isSuccess)';
+}
+
+/// Processes many still images with one filter and encoder configuration.
+///
+/// Running one [FFmpegSession] per image pays for session creation, queueing,
+/// argument parsing, and filter graph configuration on every file.  The
+/// worker instead packs up to [batchSize] items into a single session with
+/// one input and one output per item, so that cost is paid once per batch.
+///
+/// Each input still opens its own demuxer and decoder, and each output its
+/// own encoder: images of different formats and sizes cannot share one
+/// decoder/encoder chain, since an encoder cannot change resolution
+/// mid-stream.  Codec setup is therefore not amortised.
+///
+/// Items are independent: if a batch fails (for example because one input is
+/// corrupt), it is split in halves and each half retried, so that only the
+/// offending items are reported as failed at a cost of a few sessions per
+/// bad item rather than one per item.
+///
+/// ```dart
+/// final worker = ImageBatchWorker(
+///   filter: 'scale=320:-2',
+///   outputOptions: ['-q:v', '4'],
+/// );
+/// await for (final r in worker.process(Stream.fromIterable(items))) {
+///   if (!r.isSuccess) print('failed: ${r.item.input}');
+/// }
+/// ```
+class ImageBatchWorker {
+  /// Filter chain applied to every image (e.g. `scale=320:-2`), or `null` to
+  /// transcode without filtering.
+  final String? filter;
+
+  /// Encoder options applied to every output (e.g. `['-q:v', '4']`).
+  final List<String> outputOptions;
+
+  /// Maximum number of images handled by one session.
+  final int batchSize;
+
+  /// Whether results carry the encoded output in [ImageBatchResult.outputBytes].
+  final bool readOutputBytes;
+
+  /// Receives the log lines of every batch session.
+  final FFmpegLogCallback? logCallback;
+
+  /// Creates a new [ImageBatchWorker].
+  ImageBatchWorker({
+    this.filter,
+    this.outputOptions = const [],
+    this.batchSize = 32,
+    this.readOutputBytes = false,
+    this.logCallback,
+  }) {
+    if (batchSize < 1) {
+      throw ArgumentError.value(batchSize, 'batchSize', 'must be at least 1');
+    }
+  }
+
+  /// Processes [items] in batches and emits one result per item, in order.
+  Stream<ImageBatchResult> process(Stream<ImageBatchItem> items) async* {
+    final pending = <ImageBatchItem>[];
+    await for (final item in items) {
+      pending.add(item);
+      if (pending.length >= batchSize) {
+        yield* Stream.fromIterable(await _runBatch(List.of(pending)));
+        pending.clear();
+      }
+    }
+    if (pending.isNotEmpty) {
+      yield* Stream.fromIterable(await _runBatch(pending));
+    }
+  }
+
+  /// Processes [items] and resolves with every result, in order.
+  Future<List<ImageBatchResult>> processAll(Iterable<ImageBatchItem> items) =>
+      process(Stream.fromIterable(items)).toList();
+
+  /// Builds the FFmpeg arguments for one batch reading [inputs].
+  List<String> buildArguments(List<String> inputs, List<String> outputs) {
+    final args = <String>['-y', '-hide_banner'];
+    for (final input in inputs) {
+      args.addAll(['-i', input]);
+    }
+    if (filter != null) {
+      args.addAll([
+        '-filter_complex',
+        [
+          for (var i = 0; i < inputs.length; i++) '[$i:v]$filter[o$i]',
+        ].join(';'),
+      ]);
+    }
+    for (var i = 0; i < outputs.length; i++) {
+      args.addAll([
+        '-map',
+        filter != null ? '[o$i]' : '$i:v:0',
+        '-frames:v',
+        '1',
+        '-update',
+        '1',
+        ...outputOptions,
+        outputs[i],
+      ]);
+    }
+    return args;
+  }
+
+  Future<List<ImageBatchResult>> _runBatch(List<ImageBatchItem> items) async {
+    Directory? scratch;
+    try {
+      // In-memory sources are staged as files because a single session cannot
+      // read several pipes without risking a demuxer deadlock.
+      final inputs = <String>[];
+      for (var i = 0; i < items.length; i++) {
+        final item = items[i];
+        if (item.input != null) {
+          inputs.add(item.input!);
+          continue;
+        }
+        scratch ??= await Directory.systemTemp.createTemp('ffmpeg_kit_img');
+        final staged = p.join(scratch.path, 'in_$i');
+        await File(staged).writeAsBytes(item.bytes!, flush: false);
+        inputs.add(staged);
+      }
+
+      for (final item in items) {
+        await File(item.output).parent.create(recursive: true);
+      }
+
+      return await _runSplitting(items, inputs);
+    } catch (e, st) {
+      log(
+        'ImageBatchWorker: error processing batch of ${items.length} images',
+        error: e,
+        stackTrace: st,
+      );
+      return [
+        for (final item in items)
+          ImageBatchResult._(item, false, error: e.toString()),
+      ];
+    } finally {
+      if (scratch != null) {
+        try {
+          await scratch.delete(recursive: true);
+        } catch (_) {}
+      }
+    }
+  }
+
+  /// Runs [items] in one session; on failure, retries each half so that only
+  /// the offending items fail.
+  Future<List<ImageBatchResult>> _runSplitting(
+    List<ImageBatchItem> items,
+    List<String> inputs,
+  ) async {
+    final session = await _execute(
+      inputs,
+      items.map((i) => i.output).toList(),
+    );
+    if (ReturnCode.isSuccess(session.getReturnCode())) {
+      return [for (final item in items) await _collect(item, null)];
+    }
+    if (items.length == 1) {
+      return [await _collect(items.single, session.getLogsAsString())];
+    }
+    final half = items.length ~/ 2;
+    return [
+      ...await _runSplitting(items.sublist(0, half), inputs.sublist(0, half)),
+      ...await _runSplitting(items.sublist(half), inputs.sublist(half)),
+    ];
+  }
+
+  Future<FFmpegSession> _execute(List<String> inputs, List<String> outputs) =>
+      FFmpegSession.fromArguments(
+        buildArguments(inputs, outputs),
+        logCallback: logCallback,
+      ).executeAsync();
+
+  Future<ImageBatchResult> _collect(ImageBatchItem item, String? error) async {
+    final file = File(item.output);
+    if (error != null || !await file.exists() || await file.length() == 0) {
+      return ImageBatchResult._(item, false, error: error ?? 'No output');
+    }
+    return ImageBatchResult._(
+      item,
+      true,
+      outputBytes: readOutputBytes ? await file.readAsBytes() : null,
+    );
+  }
+}
@@ -0,0 +1,357 @@
+/*
+ * FFmpegKit Flutter Extended Plugin - A wrapper library for FFmpeg
+ * Copyright (C) 2026 Akash Patel
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+import 'dart:async';
+import 'dart:collection';
+import 'dart:convert';
+import 'dart:developer';
+import 'dart:io';
+import 'dart:isolate';
+import 'dart:typed_data';
+
+import 'package:crypto/crypto.dart';
+import 'package:path/path.dart' as p;
+
+import 'fast_probe.dart';
+import 'ffmpeg_kit_extended.dart';
+import 'file_identity.dart';
+
+/// Keyframe positions of one stream of a media file.
+///
+/// Built by a single demux-only ffprobe pass over the packet headers (no
+/// decoding), and stored as parallel typed arrays so that an index for a
+/// multi-hour capture occupies a few hundred kilobytes at most.  Entry `i`
+/// describes the `i`-th keyframe in presentation order.
+///
+/// ```dart
+/// final index = await KeyframeIndex.build('/captures/match.ts');
+/// final start = index.keyframeBefore(754.2); // snap a cut to a keyframe
+/// final cuts = index.splitPoints(const Duration(seconds: 6));
+/// ```
+class KeyframeIndex {
+  /// The indexed media file.
+  final String path;
+
+  /// Keyframe presentation times in seconds, ascending.
+  final Float64List times;
+
+  /// Byte offset of each keyframe packet, or `-1` when the demuxer does not
+  /// report one.
+  final Int64List positions;
+
+  /// Number of packets from each keyframe up to (excluding) the next one.
+  final Int32List gopSizes;
+
+  /// Timestamp of the last packet of the stream in seconds.
+  final double endTime;
+
+  static const int _magic = 0x4B464931; // 'KFI1'
+  static const int _headerLength = 16;
+
+  /// Creates a [KeyframeIndex] from its parallel arrays.
+  KeyframeIndex(
+    this.path,
+    this.times,
+    this.positions,
+    this.gopSizes, {
+    required this.endTime,
+  }) {
+    if (positions.length != times.length || gopSizes.length != times.length) {
+      throw ArgumentError('times, positions and gopSizes differ in length');
+    }
+  }
+
+  /// Number of keyframes.
+  int get length => times.length;
+
+  /// Whether the stream has no keyframes.
+  bool get isEmpty => times.isEmpty;
+
+  /// Index of the last keyframe at or before [seconds], or `0` when
+  /// [seconds] precedes the first keyframe.  Returns `-1` if [isEmpty].
+  int indexBefore(double seconds) {
+    if (isEmpty) return -1;
+    var low = 0;
+    var high = times.length - 1;
+    while (low < high) {
+      final mid = (low + high + 1) >> 1;
+      if (times[mid] <= seconds) {
+        low = mid;
+      } else {
+        high = mid - 1;
+      }
+    }
+    return low;
+  }
+
+  /// Time of the last keyframe at or before [seconds], or `null` if [isEmpty].
+  double? keyframeBefore(double seconds) {
+    final i = indexBefore(seconds);
+    return i < 0 ? null : times[i];
+  }
+
+  /// Time of the first keyframe at or after [seconds], or `null` if there is
+  /// none.
+  double? keyframeAfter(double seconds) {
+    final i = indexBefore(seconds);
+    if (i < 0) return null;
+    if (times[i] >= seconds) return times[i];
+    return i + 1 < times.length ? times[i + 1] : null;
+  }
+
+  /// Keyframe times at which to split the stream into segments of at least
+  /// [target] duration, starting with the first keyframe.
+  ///
+  /// Every returned time is a keyframe, so each segment can be cut with
+  /// stream copy (`-ss <t> -c copy`).
+  List<double> splitPoints(Duration target) {
+    final step = target.inMicroseconds / Duration.microsecondsPerSecond;
+    final points = <double>[];
+    for (var i = 0; i < times.length; i++) {
+      if (points.isEmpty || times[i] - points.last >= step) {
+        points.add(times[i]);
+      }
+    }
+    return points;
+  }
+
+  /// Serialises the index into its compact binary form.
+  Uint8List toBytes() {
+    final n = times.length;
+    final data = ByteData(_headerLength + n * 20)
+      ..setUint32(0, _magic, Endian.little)
+      ..setUint32(4, n, Endian.little)
+      ..setFloat64(8, endTime, Endian.little);
+    var offset = _headerLength;
+    for (var i = 0; i < n; i++, offset += 8) {
+      data.setFloat64(offset, times[i], Endian.little);
+    }
+    for (var i = 0; i < n; i++, offset += 8) {
+      data.setInt64(offset, positions[i], Endian.little);
+    }
+    for (var i = 0; i < n; i++, offset += 4) {
+      data.setInt32(offset, gopSizes[i], Endian.little);
+    }
+    return data.buffer.asUint8List();
+  }
+
+  /// Restores an index written by [toBytes].
+  ///
+  /// Throws [FormatException] if [bytes] is not a valid index.
+  factory KeyframeIndex.fromBytes(String path, Uint8List bytes) {
+    final data = ByteData.sublistView(bytes);
+    if (bytes.length < _headerLength ||
+        data.getUint32(0, Endian.little) != _magic) {
+      throw const FormatException('Not a keyframe index');
+    }
+    final n = data.getUint32(4, Endian.little);
+    if (bytes.length != _headerLength + n * 20) {
+      throw const FormatException('Truncated keyframe index');
+    }
+    final times = Float64List(n);
+    final positions = Int64List(n);
+    final gopSizes = Int32List(n);
+    var offset = _headerLength;
+    for (var i = 0; i < n; i++, offset += 8) {
+      times[i] = data.getFloat64(offset, Endian.little);
+    }
+    for (var i = 0; i < n; i++, offset += 8) {
+      positions[i] = data.getInt64(offset, Endian.little);
+    }
+    for (var i = 0; i < n; i++, offset += 4) {
+      gopSizes[i] = data.getInt32(offset, Endian.little);
+    }
+    return KeyframeIndex(
+      path,
+      times,
+      positions,
+      gopSizes,
+      endTime: data.getFloat64(8, Endian.little),
+    );
+  }
+
+  /// Indexes [stream] (an ffprobe stream specifier) of [path] on a
+  /// background isolate.
+  ///
+  /// Throws [ProbeException] if the input cannot be read.
+  static Future<KeyframeIndex> build(
+    String path, {
+    String stream = 'v:0',
+  }) async {
+    FFmpegKitExtended.requireInitialized();
+    final arguments = buildArguments(path, stream: stream);
+    return Isolate.run(() {
+      final (returnCode, output) = FastProbe.executeSync(arguments);
+      if (returnCode != 0) {
+        throw ProbeException(path, returnCode, output.trim());
+      }
+      return parseOutput(path, output);
+    }, debugName: 'KeyframeIndex');
+  }
+
+  /// Builds the ffprobe arguments used by [build].
+  static List<String> buildArguments(String path, {String stream = 'v:0'}) => [
+    '-v',
+    'error',
+    '-hide_banner',
+    '-select_streams',
+    stream,
+    '-show_entries',
+    'packet=pts_time,dts_time,pos,flags',
+    '-of',
+    'csv=p=0',
+    path,
+  ];
+
+  /// Parses the `pts_time,dts_time,pos,flags` CSV lines written by the
+  /// command from [buildArguments].
+  static KeyframeIndex parseOutput(String path, String output) {
+    final times = <double>[];
+    final positions = <int>[];
+    final gopSizes = <int>[];
+    var endTime = 0.0;
+    var sorted = true;
+    for (final line in const LineSplitter().convert(output)) {
+      final fields = line.split(',');
+      if (fields.length < 4) continue;
+      final time = double.tryParse(fields[0]) ?? double.tryParse(fields[1]);
+      if (time == null) continue;
+      if (time > endTime) endTime = time;
+      if (!fields[3].startsWith('K')) {
+        if (gopSizes.isNotEmpty) gopSizes[gopSizes.length - 1]++;
+        continue;
+      }
+      if (times.isNotEmpty && time < times.last) sorted = false;
+      times.add(time);
+      positions.add(int.tryParse(fields[2]) ?? -1);
+      gopSizes.add(1);
+    }
+
+    final order = List<int>.generate(times.length, (i) => i);
+    if (!sorted) order.sort((a, b) => times[a].compareTo(times[b]));
+    return KeyframeIndex(
+      path,
+      Float64List.fromList([for (final i in order) times[i]]),
+      Int64List.fromList([for (final i in order) positions[i]]),
+      Int32List.fromList([for (final i in order) gopSizes[i]]),
+      endTime: endTime,
+    );
+  }
+
+  @override
+  String toString() =>
+      'KeyframeIndex($path, keyframes: $length, end: ${endTime}s)';
+}
+
+/// Cache of [KeyframeIndex]es keyed by file identity.
+///
+/// Indexes are kept in memory for the most recently used files and, when
+/// [directory] is given, persisted there as one small binary file per media
+/// file, so a file is demuxed at most once for as long as it is unchanged.
+/// The media information cache's directory is a natural place for it.
+/// Concurrent requests for the same file coalesce onto one build; inputs that
+/// are not local files are indexed without caching.
+class KeyframeIndexCache {
+  /// Directory holding persisted indexes, or `null` for an in-memory cache.
+  final String? directory;
+
+  /// Maximum number of indexes kept in memory.
+  final int maxMemoryEntries;
+
+  final LinkedHashMap<String, KeyframeIndex> _memory =
+      LinkedHashMap<String, KeyframeIndex>();
+  final Map<String, Future<KeyframeIndex>> _inFlight = {};
+
+  /// Creates a new [KeyframeIndexCache].
+  KeyframeIndexCache({this.directory, this.maxMemoryEntries = 32});
+
+  /// Returns the keyframe index of the first video stream of [path],
+  /// building it on a cache miss.
+  ///
+  /// Throws [ProbeException] if the input cannot be read.
+  Future<KeyframeIndex> getIndex(String path) async {
+    final identity = await fileIdentity(path);
+    if (identity == null) return KeyframeIndex.build(path);
+    final key = sha256.convert(utf8.encode(identity)).toString();
+
+    final hot = _memory.remove(key);
+    if (hot != null) return _memory[key] = hot;
+
+    final inFlight = _inFlight[key];
+    if (inFlight != null) return inFlight;
+
+    final future = _load(key, path);
+    _inFlight[key] = future;
+    try {
+      final index = await future;
+      _memory[key] = index;
+      while (_memory.length > maxMemoryEntries) {
+        _memory.remove(_memory.keys.first);
+      }
+      return index;
+    } finally {
+      _inFlight.remove(key);
+    }
+  }
+
+  /// Drops the cached index for the current version of [path].
+  Future<void> invalidate(String path) async {
+    final identity = await fileIdentity(path);
+    if (identity == null) return;
+    final key = sha256.convert(utf8.encode(identity)).toString();
+    _memory.remove(key);
+    final directory = this.directory;
+    if (directory == null) return;
+    final file = File(p.join(directory, '$key.kfi'));
+    if (await file.exists()) await file.delete();
+  }
+
+  Future<KeyframeIndex> _load(String key, String path) async {
+    final directory = this.directory;
+    if (directory == null) return KeyframeIndex.build(path);
+
+    final file = File(p.join(directory, '$key.kfi'));
+    if (await file.exists()) {
+      try {
+        return KeyframeIndex.fromBytes(path, await file.readAsBytes());
+      } catch (e, st) {
+        log(
+          'KeyframeIndexCache: error reading ${file.path}, rebuilding',
+          error: e,
+          stackTrace: st,
+        );
+      }
+    }
+
+    final index = await KeyframeIndex.build(path);
+    try {
+      await Directory(directory).create(recursive: true);
+      final tmp = File('${file.path}.tmp');
+      await tmp.writeAsBytes(index.toBytes(), flush: true);
+      await tmp.rename(file.path);
+    } on FileSystemException catch (e, st) {
+      log(
+        'KeyframeIndexCache: error writing ${file.path}',
+        error: e,
+        stackTrace: st,
+      );
+    }
+    return index;
+  }
+}
@@ -0,0 +1,166 @@
+/*
+ * FFmpegKit Flutter Extended Plugin - A wrapper library for FFmpeg
+ * Copyright (C) 2026 Akash Patel
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+import 'dart:ffi';
+import 'dart:io';
+import 'dart:math' as math;
+
+import 'package:ffi/ffi.dart';
+import 'package:path/path.dart' as p;
+
+/// The few libc entry points used for descriptor-level file access.
+///
+/// Only available where [Platform.isLinux], [Platform.isAndroid],
+/// [Platform.isMacOS] or [Platform.isIOS].
+class LibC {
+  static const int seekSet = 0;
+  static const int seekCur = 1;
+  static const int seekEnd = 2;
+  static const int fadviseWillNeed = 3;
+
+  static final LibC instance = LibC._(
+    Platform.isAndroid
+        ? DynamicLibrary.open('libc.so')
+        : DynamicLibrary.process(),
+  );
+
+  final DynamicLibrary _lib;
+  final int Function(Pointer<Utf8>, int, int) _open;
+  final int Function(Pointer<Utf8>) _unlink;
+  final int Function(int) close;
+  final int Function(int, Pointer<Uint8>, int) write;
+  final int Function(int, Pointer<Uint8>, int, int) pread;
+  final int Function(int, int, int) seek;
+  final int Function(int, int) truncate;
+  final Pointer<Int32> Function() _errnoLocation;
+
+  /// `posix_fadvise`, or `null` where it does not exist (Darwin).
+  final int Function(int, int, int, int)? fadvise;
+
+  LibC._(DynamicLibrary lib)
+    : _lib = lib,
+      // open() is variadic; the mode must be passed as a variadic argument.
+      _open = lib.lookupFunction<
+        Int32 Function(Pointer<Utf8>, Int32, VarArgs<(Int32,)>),
+        int Function(Pointer<Utf8>, int, int)
+      >('open'),
+      _unlink = lib.lookupFunction<
+        Int32 Function(Pointer<Utf8>),
+        int Function(Pointer<Utf8>)
+      >('unlink'),
+      close = lib.lookupFunction<Int32 Function(Int32), int Function(int)>(
+        'close',
+      ),
+      write = lib.lookupFunction<
+        IntPtr Function(Int32, Pointer<Uint8>, Size),
+        int Function(int, Pointer<Uint8>, int)
+      >('write'),
+      pread = lib.lookupFunction<
+        IntPtr Function(Int32, Pointer<Uint8>, Size, Int64),
+        int Function(int, Pointer<Uint8>, int, int)
+      >(_isDarwin ? 'pread' : 'pread64'),
+      seek = lib.lookupFunction<
+        Int64 Function(Int32, Int64, Int32),
+        int Function(int, int, int)
+      >(_isDarwin ? 'lseek' : 'lseek64'),
+      truncate = lib.lookupFunction<
+        Int32 Function(Int32, Int64),
+        int Function(int, int)
+      >(_isDarwin ? 'ftruncate' : 'ftruncate64'),
+      _errnoLocation = lib.lookupFunction<
+        Pointer<Int32> Function(),
+        Pointer<Int32> Function()
+      >(_errnoSymbol),
+      fadvise = _isDarwin
+          ? null
+          : lib.lookupFunction<
+              Int32 Function(Int32, Int64, Int64, Int32),
+              int Function(int, int, int, int)
+            >('posix_fadvise64');
+
+  static String get _errnoSymbol {
+    if (_isDarwin) return '__error';
+    return Platform.isAndroid ? '__errno' : '__errno_location';
+  }
+
+  static bool get _isDarwin => Platform.isMacOS || Platform.isIOS;
+
+  int get errno => _errnoLocation().value;
+
+  /// Opens [path] read-only and returns the descriptor, or `-1`.
+  int openReadOnly(String path) {
+    final oCloexec = _isDarwin ? 0x01000000 : 0x00080000;
+    final cPath = path.toNativeUtf8();
+    try {
+      return _open(cPath, oCloexec, 0);
+    } finally {
+      malloc.free(cPath);
+    }
+  }
+
+  /// Returns a new descriptor for an anonymous read/write file.
+  int createAnonymous(String name) {
+    final cName = name.toNativeUtf8();
+    try {
+      if (!_isDarwin) {
+        try {
+          final memfdCreate = _lib.lookupFunction<
+            Int32 Function(Pointer<Utf8>, Uint32),
+            int Function(Pointer<Utf8>, int)
+          >('memfd_create');
+          const mfdCloexec = 0x0001;
+          final fd = memfdCreate(cName, mfdCloexec);
+          if (fd >= 0) return fd;
+        } on ArgumentError {
+          // memfd_create is not exported (Android before API 30).
+        }
+      }
+      return _createUnlinked(name);
+    } finally {
+      malloc.free(cName);
+    }
+  }
+
+  int _createUnlinked(String name) {
+    const oRdwr = 0x0002;
+    final oCreat = _isDarwin ? 0x0200 : 0x0040;
+    final oExcl = _isDarwin ? 0x0800 : 0x0080;
+    final oCloexec = _isDarwin ? 0x01000000 : 0x00080000;
+    final random = math.Random();
+    for (var attempt = 0; attempt < 16; attempt++) {
+      final path = p.join(
+        Directory.systemTemp.path,
+        '.$name-$pid-${random.nextInt(1 << 32).toRadixString(16)}',
+      );
+      final cPath = path.toNativeUtf8();
+      try {
+        final fd = _open(cPath, oRdwr | oCreat | oExcl | oCloexec, 0x180);
+        if (fd < 0) continue;
+        _unlink(cPath);
+        return fd;
+      } finally {
+        malloc.free(cPath);
+      }
+    }
+    throw FileSystemException(
+      'Cannot create an anonymous file (errno $errno)',
+      Directory.systemTemp.path,
+    );
+  }
+}
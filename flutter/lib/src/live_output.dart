@@ -0,0 +1,310 @@
+/*
+ * FFmpegKit Flutter Extended Plugin - A wrapper library for FFmpeg
+ * Copyright (C) 2026 Akash Patel
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+import 'dart:async';
+import 'dart:convert';
+import 'dart:io';
+import 'dart:typed_data';
+
+import 'package:meta/meta.dart';
+import 'package:path/path.dart' as p;
+
+import 'ffmpeg_pipe.dart';
+
+/// Kind of an [OutputChunk].
+enum OutputChunkKind {
+  /// Initialisation segment of a fragmented MP4 (`ftyp` + `moov`).
+  init,
+
+  /// A complete media fragment (`moof` + `mdat`, with any leading `styp`,
+  /// `sidx` or `prft` boxes).
+  fragment,
+
+  /// A complete segment file written by the segment muxer.
+  segment,
+}
+
+/// A completed piece of live encoder output, ready to be uploaded.
+class OutputChunk {
+  /// What this chunk contains.
+  final OutputChunkKind kind;
+
+  /// Zero-based sequence number among chunks of the same output.
+  final int sequence;
+
+  /// Byte offset of this chunk in the concatenated output.
+  final int offset;
+
+  /// The chunk's bytes, or `null` for a segment read with
+  /// [SegmentListOutput.readBytes] disabled.
+  final Uint8List? bytes;
+
+  /// Path of the segment file, for [OutputChunkKind.segment] chunks.
+  final String? path;
+
+  /// Start time of the segment, when reported by the muxer.
+  final Duration? start;
+
+  /// End time of the segment, when reported by the muxer.
+  final Duration? end;
+
+  const OutputChunk._(
+    this.kind,
+    this.sequence,
+    this.offset, {
+    this.bytes,
+    this.path,
+    this.start,
+    this.end,
+  });
+
+  /// Size of [bytes], or `null` when the bytes were not read.
+  int? get length => bytes?.length;
+
+  @override
+  String toString() =>
+      'OutputChunk(${kind.name} #$sequence, offset: $offset, '
+      'length: $length${path != null ? ', path: $path' : ''})';
+}
+
+/// Streams fragmented MP4 output one complete fragment at a time.
+///
+/// The muxer writes to an [FFmpegPipeOutput]; box headers are tracked as the
+/// bytes arrive, and every fragment is emitted as soon as its `mdat` box is
+/// complete, so an upload can start within one [fragmentDuration] of the
+/// encoder producing it.  The first chunk is the initialisation segment.
+///
+/// Only one fragment is assembled at a time and the pipe is not read while
+/// the [chunks] subscription is paused, so a slow uploader blocks the muxer
+/// instead of growing memory.
+///
+/// ```dart
+/// final output = FragmentedMp4Output();
+/// final uploads = output.chunks.asyncMap(uploader.put).drain<void>();
+/// await FFmpegPipes.executeAsync(
+///   FFmpegSession.fromArguments([
+///     '-i', input, '-c:v', 'libx264', '-g', '60',
+///     ...output.outputArguments,
+///   ]),
+///   outputs: [output.pipe],
+/// );
+/// await uploads;
+/// ```
+class FragmentedMp4Output {
+  /// Target duration of each fragment; fragments still start on keyframes.
+  final Duration fragmentDuration;
+
+  /// The pipe the muxer writes to; pass it to [FFmpegPipes.executeAsync].
+  final FFmpegPipeOutput pipe;
+
+  /// Creates a new [FragmentedMp4Output].
+  FragmentedMp4Output({this.fragmentDuration = const Duration(seconds: 2)})
+    : pipe = FFmpegPipeOutput();
+
+  /// Output arguments selecting fragmented MP4 on [pipe].
+  List<String> get outputArguments => [
+    '-movflags',
+    'frag_keyframe+empty_moov+default_base_moof+skip_trailer',
+    '-frag_duration',
+    '${fragmentDuration.inMicroseconds}',
+    '-f',
+    'mp4',
+    pipe.path,
+  ];
+
+  /// Completed chunks, in output order.  Single-subscription.
+  late final Stream<OutputChunk> chunks = splitFragments(pipe.stream);
+
+  /// Splits a fragmented MP4 byte stream into [OutputChunk]s.
+  @visibleForTesting
+  static Stream<OutputChunk> splitFragments(Stream<List<int>> input) async* {
+    final group = BytesBuilder(copy: false);
+    final header = Uint8List(16);
+    var headerFill = 0;
+    var headerLength = 8;
+    var remaining = 0; // Body bytes left in the current box; -1: until EOF.
+    var inBody = false;
+    var endsGroup = false;
+    var offset = 0;
+    var sequence = 0;
+    var sawInit = false;
+
+    OutputChunk take(OutputChunkKind kind) {
+      final bytes = group.takeBytes();
+      final chunk = OutputChunk._(kind, sequence++, offset, bytes: bytes);
+      offset += bytes.length;
+      return chunk;
+    }
+
+    await for (final data in input) {
+      final chunk = data is Uint8List ? data : Uint8List.fromList(data);
+      var position = 0;
+      var groupStart = 0;
+      while (position < chunk.length) {
+        if (!inBody) {
+          final n = _min(headerLength - headerFill, chunk.length - position);
+          header.setRange(headerFill, headerFill + n, chunk, position);
+          headerFill += n;
+          position += n;
+          if (headerFill < headerLength) continue;
+
+          final view = ByteData.sublistView(header);
+          final size32 = view.getUint32(0);
+          if (size32 == 1 && headerLength == 8) {
+            headerLength = 16; // 64-bit `largesize` follows the type.
+            continue;
+          }
+          final type = ascii.decode(header.sublist(4, 8), allowInvalid: true);
+          final size = size32 == 1 ? view.getUint64(8) : size32;
+          remaining = size32 == 0 ? -1 : size - headerLength;
+          endsGroup = type == 'moov' || type == 'mdat';
+          inBody = true;
+          headerFill = 0;
+          headerLength = 8;
+        } else if (remaining != 0) {
+          final available = chunk.length - position;
+          final n = remaining < 0 ? available : _min(remaining, available);
+          position += n;
+          if (remaining > 0) remaining -= n;
+        }
+
+        if (inBody && remaining == 0) {
+          inBody = false;
+          if (endsGroup) {
+            group.add(Uint8List.sublistView(chunk, groupStart, position));
+            groupStart = position;
+            yield take(
+              sawInit ? OutputChunkKind.fragment : OutputChunkKind.init,
+            );
+            sawInit = true;
+          }
+        }
+      }
+      if (groupStart < chunk.length) {
+        group.add(Uint8List.sublistView(chunk, groupStart));
+      }
+    }
+    if (group.isNotEmpty) {
+      yield take(sawInit ? OutputChunkKind.fragment : OutputChunkKind.init);
+    }
+  }
+
+  static int _min(int a, int b) => a < b ? a : b;
+}
+
+/// Streams segment files as the segment muxer completes them.
+///
+/// Segments are written to [directory] by FFmpeg's `segment` muxer, which
+/// also appends one CSV line per finished segment to a segment list.  The
+/// list is an [FFmpegPipeOutput], so each segment is reported the moment it
+/// is closed rather than by polling the directory.  Use this for MPEG-TS
+/// (HLS-style) or self-contained MP4 segments.
+///
+/// There is no back-pressure: the muxer writes one short line to the list
+/// per segment, which never fills the pipe, so pausing [chunks] does not
+/// slow encoding.  Segments keep accumulating in [directory] until the
+/// consumer catches up and removes them.
+class SegmentListOutput {
+  /// Directory receiving the segment files.
+  final String directory;
+
+  /// Target duration of each segment; segments still start on keyframes.
+  final Duration segmentDuration;
+
+  /// Container of each segment (`mpegts`, `mp4`, ...).
+  final String format;
+
+  /// Whether chunks carry the segment's bytes in [OutputChunk.bytes].
+  final bool readBytes;
+
+  /// The segment list pipe; pass it to [FFmpegPipes.executeAsync].
+  final FFmpegPipeOutput pipe;
+
+  /// Creates a new [SegmentListOutput].
+  SegmentListOutput({
+    required this.directory,
+    this.segmentDuration = const Duration(seconds: 4),
+    this.format = 'mpegts',
+    this.readBytes = true,
+  }) : pipe = FFmpegPipeOutput();
+
+  /// Output arguments selecting the segment muxer with its list on [pipe].
+  List<String> get outputArguments => [
+    '-f',
+    'segment',
+    '-segment_time',
+    '${segmentDuration.inMicroseconds / Duration.microsecondsPerSecond}',
+    '-segment_format',
+    format,
+    '-segment_list',
+    pipe.path,
+    '-segment_list_type',
+    'csv',
+    '-reset_timestamps',
+    '1',
+    p.join(directory, 'segment_%05d.${format == 'mpegts' ? 'ts' : format}'),
+  ];
+
+  /// Completed segments, in output order.  Single-subscription.
+  late final Stream<OutputChunk> chunks = _segments();
+
+  Stream<OutputChunk> _segments() async* {
+    await Directory(directory).create(recursive: true);
+    var sequence = 0;
+    var offset = 0;
+    final lines = pipe.stream
+        .cast<List<int>>()
+        .transform(utf8.decoder)
+        .transform(const LineSplitter());
+    await for (final line in lines) {
+      final entry = parseListEntry(line);
+      if (entry == null) continue;
+      final path = p.join(directory, p.basename(entry.$1));
+      final bytes = readBytes ? await File(path).readAsBytes() : null;
+      yield OutputChunk._(
+        OutputChunkKind.segment,
+        sequence++,
+        offset,
+        bytes: bytes,
+        path: path,
+        start: entry.$2,
+        end: entry.$3,
+      );
+      offset += bytes?.length ?? await File(path).length();
+    }
+  }
+
+  /// Parses one `filename,start,end` line of a CSV segment list.
+  @visibleForTesting
+  static (String, Duration, Duration)? parseListEntry(String line) {
+    final end = line.lastIndexOf(',');
+    final start = end <= 0 ? -1 : line.lastIndexOf(',', end - 1);
+    if (start <= 0) return null;
+    var name = line.substring(0, start);
+    if (name.length >= 2 && name.startsWith('"') && name.endsWith('"')) {
+      name = name.substring(1, name.length - 1).replaceAll('""', '"');
+    }
+    final startSeconds = double.tryParse(line.substring(start + 1, end));
+    final endSeconds = double.tryParse(line.substring(end + 1));
+    if (startSeconds == null || endSeconds == null) return null;
+    Duration seconds(double s) =>
+        Duration(microseconds: (s * Duration.microsecondsPerSecond).round());
+    return (name, seconds(startSeconds), seconds(endSeconds));
+  }
+}
@@ -17,6 +17,7 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
  */
 
+import 'dart:collection';
 import 'dart:convert';
 import 'chapter_information.dart';
 import 'stream_information.dart';
@@ -51,24 +52,16 @@ class MediaInformation {
   final String? allPropertiesJson;
 
   /// Parsed map of tags from keys to values.
-  Map<String, dynamic>? get tags {
-    if (tagsJson == null || tagsJson!.isEmpty) return null;
-    try {
-      return jsonDecode(tagsJson!);
-    } catch (_) {
-      return null;
-    }
-  }
+  ///
+  /// Only [tagsJson] is retained; it is decoded on first access into a
+  /// read-only map.
+  late final Map<String, dynamic>? tags = _decodeObject(tagsJson);
 
   /// Parsed map of all properties from keys to values.
-  Map<String, dynamic>? get allProperties {
-    if (allPropertiesJson == null || allPropertiesJson!.isEmpty) return null;
-    try {
-      return jsonDecode(allPropertiesJson!);
-    } catch (_) {
-      return null;
-    }
-  }
+  ///
+  /// Decoded from [allPropertiesJson] on first access, like [tags].
+  late final Map<String, dynamic>? allProperties =
+      _decodeObject(allPropertiesJson);
 
   /// The list of streams contained in the media.
   final List<StreamInformation> streams;
@@ -91,8 +84,81 @@ class MediaInformation {
     this.chapters = const [],
   });
 
+  /// Creates a [MediaInformation] from a map produced by [toJson].
+  factory MediaInformation.fromJson(Map<String, dynamic> json) =>
+      MediaInformation(
+        filename: json['filename'] as String?,
+        format: json['format'] as String?,
+        longFormat: json['longFormat'] as String?,
+        duration: json['duration'] as String?,
+        startTime: json['startTime'] as String?,
+        bitrate: json['bitrate'] as String?,
+        size: json['size'] as String?,
+        tagsJson: json['tagsJson'] as String?,
+        allPropertiesJson: json['allPropertiesJson'] as String?,
+        streams: [
+          for (final stream in (json['streams'] as List?) ?? const [])
+            StreamInformation.fromJson(stream as Map<String, dynamic>),
+        ],
+        chapters: [
+          for (final chapter in (json['chapters'] as List?) ?? const [])
+            ChapterInformation.fromJson(chapter as Map<String, dynamic>),
+        ],
+      );
+
+  /// Creates a [MediaInformation] from ffprobe's JSON output, i.e. the
+  /// document produced by `-print_format json -show_format -show_streams
+  /// -show_chapters`.
+  factory MediaInformation.fromFFprobeJson(Map<String, dynamic> json) {
+    final format = (json['format'] as Map<String, dynamic>?) ?? const {};
+    final tags = format['tags'];
+    return MediaInformation(
+      filename: format['filename'] as String?,
+      format: format['format_name'] as String?,
+      longFormat: format['format_long_name'] as String?,
+      duration: format['duration'] as String?,
+      startTime: format['start_time'] as String?,
+      bitrate: format['bit_rate'] as String?,
+      size: format['size'] as String?,
+      tagsJson: tags == null ? null : jsonEncode(tags),
+      allPropertiesJson: format.isEmpty ? null : jsonEncode(format),
+      streams: [
+        for (final stream in (json['streams'] as List?) ?? const [])
+          StreamInformation.fromFFprobeJson(stream as Map<String, dynamic>),
+      ],
+      chapters: [
+        for (final chapter in (json['chapters'] as List?) ?? const [])
+          ChapterInformation.fromFFprobeJson(chapter as Map<String, dynamic>),
+      ],
+    );
+  }
+
   /// Returns a string representation of this media information.
   @override
   String toString() =>
       'MediaInformation(filename: $filename, format: $format, duration: $duration, streams: ${streams.length}, chapters: ${chapters.length})';
+
+  /// Converts this media information to a JSON map.
+  Map<String, dynamic> toJson() => {
+    'filename': filename,
+    'format': format,
+    'longFormat': longFormat,
+    'duration': duration,
+    'startTime': startTime,
+    'bitrate': bitrate,
+    'size': size,
+    'tagsJson': tagsJson,
+    'allPropertiesJson': allPropertiesJson,
+    'streams': [for (final stream in streams) stream.toJson()],
+    'chapters': [for (final chapter in chapters) chapter.toJson()],
+  };
+
+  static Map<String, dynamic>? _decodeObject(String? json) {
+    if (json == null || json.isEmpty) return null;
+    try {
+      return UnmodifiableMapView(jsonDecode(json) as Map<String, dynamic>);
+    } catch (_) {
+      return null;
+    }
+  }
 }
@@ -0,0 +1,360 @@
+/*
+ * FFmpegKit Flutter Extended Plugin - A wrapper library for FFmpeg
+ * Copyright (C) 2026 Akash Patel
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+import 'dart:async';
+import 'dart:collection';
+import 'dart:convert';
+import 'dart:developer';
+import 'dart:io';
+import 'dart:typed_data';
+
+import 'package:crypto/crypto.dart';
+
+import 'file_identity.dart';
+import 'media_information.dart';
+import 'media_information_session.dart';
+
+/// Cache of [MediaInformation] keyed by file identity.
+///
+/// Entries are keyed by path, size, and modification time (or by a content
+/// hash when [hashContent] is set), so a file that changes on disk is probed
+/// again automatically.  Recently used entries are kept decoded in memory;
+/// when [storePath] is given every entry is also appended to a compact
+/// on-disk store that survives restarts.  Only the byte offset of each stored
+/// entry is kept in memory, and entries are decoded on first use.
+///
+/// Concurrent requests for the same key coalesce onto a single probe.
+/// Inputs that are not local files (URLs, devices) bypass the cache.
+///
+/// ```dart
+/// final cache = MediaInformationCache(storePath: '${support.path}/probe.db');
+/// for (final path in libraryPaths) {
+///   final info = await cache.getMediaInformation(path);
+///   print('${info?.duration}');
+/// }
+/// await cache.close();
+/// ```
+class MediaInformationCache {
+  /// On-disk store, or `null` for an in-memory cache.
+  final String? storePath;
+
+  /// Maximum number of decoded entries kept in memory.
+  final int maxMemoryEntries;
+
+  /// Maximum number of entries kept in the on-disk store.
+  final int maxStoreEntries;
+
+  /// Whether files are identified by a hash of their content.
+  final bool hashContent;
+
+  static const int _keyLength = 64;
+
+  final LinkedHashMap<String, MediaInformation> _memory =
+      LinkedHashMap<String, MediaInformation>();
+  final Map<String, Future<MediaInformation?>> _inFlight = {};
+
+  /// Stored entries in least- to most-recently-used order.
+  final LinkedHashMap<String, _StoreSlot> _slots =
+      LinkedHashMap<String, _StoreSlot>();
+  RandomAccessFile? _store;
+  int _storeLines = 0;
+  Future<void>? _opened;
+  Future<void> _io = Future.value();
+
+  int _hits = 0;
+  int _misses = 0;
+
+  /// Creates a new [MediaInformationCache].
+  MediaInformationCache({
+    this.storePath,
+    this.maxMemoryEntries = 1000,
+    this.maxStoreEntries = 100000,
+    this.hashContent = false,
+  });
+
+  /// Number of lookups answered without probing.
+  int get hits => _hits;
+
+  /// Number of lookups that required a probe.
+  int get misses => _misses;
+
+  /// Returns media information for [path], probing it only on a cache miss.
+  ///
+  /// Returns `null` if the probe fails; failures are not cached.
+  Future<MediaInformation?> getMediaInformation(String path) async {
+    final key = await keyFor(path);
+    if (key == null) return _probe(path);
+
+    final cached = await _lookup(key);
+    if (cached != null) {
+      _hits++;
+      return cached;
+    }
+
+    final inFlight = _inFlight[key];
+    if (inFlight != null) {
+      _hits++;
+      return inFlight;
+    }
+
+    _misses++;
+    final future = _probe(path).then((info) async {
+      if (info != null) await put(key, info);
+      return info;
+    });
+    _inFlight[key] = future;
+    try {
+      return await future;
+    } finally {
+      _inFlight.remove(key);
+    }
+  }
+
+  /// Returns the cache key for [path], or `null` if it is not a local file.
+  Future<String?> keyFor(String path) async {
+    final identity = await fileIdentity(path, hashContent: hashContent);
+    if (identity == null) return null;
+    return sha256.convert(utf8.encode(identity)).toString();
+  }
+
+  /// Stores [info] under [key].
+  Future<void> put(String key, MediaInformation info) async {
+    _remember(key, info);
+    if (storePath == null) return;
+    await _open();
+    await _write(key, utf8.encode(jsonEncode(info.toJson())));
+  }
+
+  /// Drops the entry for the current version of [path].
+  Future<void> invalidate(String path) async {
+    final key = await keyFor(path);
+    if (key == null) return;
+    _memory.remove(key);
+    if (storePath == null) return;
+    await _open();
+    await _exclusive(() async {
+      if (_slots.containsKey(key)) await _append(key, null);
+    });
+  }
+
+  /// Rewrites the on-disk store keeping only live entries.
+  Future<void> compact() async {
+    if (storePath == null) return;
+    await _open();
+    await _exclusive(_compact);
+  }
+
+  /// Flushes and closes the on-disk store.
+  Future<void> close() async {
+    if (_opened == null) return;
+    await _opened;
+    await _exclusive(() async {
+      await _store?.close();
+      _store = null;
+    });
+    _opened = null;
+  }
+
+  Future<MediaInformation?> _probe(String path) async {
+    final session = MediaInformationSession.fromPath(path);
+    await session.executeAsync();
+    return session.getMediaInformation();
+  }
+
+  Future<MediaInformation?> _lookup(String key) async {
+    final hot = _memory.remove(key);
+    if (hot != null) {
+      _memory[key] = hot;
+      return hot;
+    }
+    if (storePath == null) return null;
+    await _open();
+    _StoreSlot? slot;
+    final bytes = await _exclusive(() async {
+      slot = _slots.remove(key);
+      if (slot == null) return null;
+      final store = _store!;
+      await store.setPosition(slot!.offset);
+      final bytes = await store.read(slot!.length);
+      _slots[key] = slot!;
+      return bytes;
+    });
+    if (bytes == null) return null;
+    try {
+      final info = MediaInformation.fromJson(
+        jsonDecode(utf8.decode(bytes)) as Map<String, dynamic>,
+      );
+      _remember(key, info);
+      return info;
+    } catch (e, st) {
+      log(
+        'MediaInformationCache: error decoding stored entry $key',
+        error: e,
+        stackTrace: st,
+      );
+      // Leave the slot alone if a write or compaction has replaced it since.
+      await _exclusive(() async {
+        if (identical(_slots[key], slot)) _slots.remove(key);
+      });
+      return null;
+    }
+  }
+
+  void _remember(String key, MediaInformation info) {
+    _memory
+      ..remove(key)
+      ..[key] = info;
+    while (_memory.length > maxMemoryEntries) {
+      _memory.remove(_memory.keys.first);
+    }
+  }
+
+  Future<T> _exclusive<T>(Future<T> Function() body) {
+    final result = _io.then((_) => body());
+    _io = result.then((_) {}, onError: (_) {});
+    return result;
+  }
+
+  Future<void> _open() => _opened ??= _exclusive(() async {
+    final file = File(storePath!);
+    await file.parent.create(recursive: true);
+    _slots.clear();
+    _storeLines = 0;
+    var valid = 0;
+    if (await file.exists()) {
+      try {
+        valid = await _index(file);
+      } catch (e, st) {
+        log(
+          'MediaInformationCache: error reading store $storePath, starting empty',
+          error: e,
+          stackTrace: st,
+        );
+        _slots.clear();
+        _storeLines = 0;
+      }
+    }
+    final store = await file.open(mode: FileMode.append);
+    // Drop a torn trailing write (or an unreadable store) before appending.
+    if (await store.length() != valid) await store.truncate(valid);
+    _store = store;
+  });
+
+  /// Builds [_slots] from the store without decoding any entry.
+  ///
+  /// Each line is `<64-char key> <json>\n`; an empty payload is a tombstone.
+  /// Returns the length of the well-formed prefix of the store.
+  Future<int> _index(File file) async {
+    var offset = 0;
+    final line = BytesBuilder(copy: false);
+    var lineStart = 0;
+    await for (final chunk in file.openRead()) {
+      var start = 0;
+      for (var i = 0; i < chunk.length; i++) {
+        if (chunk[i] != 0x0A) continue;
+        line.add(Uint8List.sublistView(chunk, start, i));
+        _indexLine(line.takeBytes(), lineStart);
+        start = i + 1;
+        lineStart = offset + start;
+      }
+      line.add(Uint8List.sublistView(chunk, start));
+      offset += chunk.length;
+    }
+    return lineStart;
+  }
+
+  void _indexLine(Uint8List bytes, int lineStart) {
+    if (bytes.length < _keyLength + 1) return;
+    _storeLines++;
+    final key = ascii.decode(bytes.sublist(0, _keyLength));
+    _slots.remove(key);
+    final length = bytes.length - _keyLength - 1;
+    if (length > 0) {
+      _slots[key] = _StoreSlot(lineStart + _keyLength + 1, length);
+    }
+  }
+
+  Future<void> _write(String key, List<int>? payload) =>
+      _exclusive(() => _append(key, payload));
+
+  /// Must run inside [_exclusive].
+  Future<void> _append(String key, List<int>? payload) async {
+    final store = _store!;
+    final position = await store.length();
+    await store.setPosition(position);
+    await store.writeFrom([
+      ...ascii.encode(key),
+      0x20,
+      ...?payload,
+      0x0A,
+    ]);
+    _storeLines++;
+    _slots.remove(key);
+    if (payload != null) {
+      _slots[key] = _StoreSlot(position + _keyLength + 1, payload.length);
+    }
+    if (_slots.length > maxStoreEntries ||
+        _storeLines > 2 * _slots.length + 1024) {
+      await _compact();
+    }
+  }
+
+  /// Must run inside [_exclusive].
+  Future<void> _compact() async {
+    final store = _store!;
+    while (_slots.length > maxStoreEntries) {
+      _slots.remove(_slots.keys.first);
+    }
+    final tmp = File('$storePath.tmp');
+    final out = await tmp.open(mode: FileMode.write);
+    final compacted = LinkedHashMap<String, _StoreSlot>();
+    var position = 0;
+    try {
+      for (final entry in _slots.entries) {
+        await store.setPosition(entry.value.offset);
+        final payload = await store.read(entry.value.length);
+        await out.writeFrom([...ascii.encode(entry.key), 0x20]);
+        await out.writeFrom(payload);
+        await out.writeByte(0x0A);
+        compacted[entry.key] = _StoreSlot(
+          position + _keyLength + 1,
+          payload.length,
+        );
+        position += _keyLength + 1 + payload.length + 1;
+      }
+      await out.flush();
+    } finally {
+      await out.close();
+    }
+    await store.close();
+    await tmp.rename(storePath!);
+    _store = await File(storePath!).open(mode: FileMode.append);
+    _slots
+      ..clear()
+      ..addAll(compacted);
+    _storeLines = compacted.length;
+  }
+}
+
+class _StoreSlot {
+  final int offset;
+  final int length;
+
+  const _StoreSlot(this.offset, this.length);
+}
@@ -18,6 +18,7 @@
  */
 
 import 'dart:async';
+import 'dart:convert';
 import 'dart:developer';
 import 'dart:ffi';
 import 'dart:io';
@@ -39,6 +40,8 @@ class MediaInformationSession extends FFprobeSession {
 
   int _timeout;
 
+  MediaInformation? _mediaInformation;
+
   // ---------------------------------------------------------------------------
   // Default ffprobe command fragments
   // ---------------------------------------------------------------------------
@@ -414,11 +417,41 @@ class MediaInformationSession extends FFprobeSession {
 
   /// Retrieves the [MediaInformation] parsed from the ffprobe output.
   ///
+  /// The JSON document ffprobe printed is fetched with a single native call
+  /// and decoded once; the result is cached on the session.  Sessions whose
+  /// output is not an ffprobe JSON document fall back to reading the native
+  /// media information object field by field.
+  ///
   /// Returns `null` if the session has not completed or the output could not
   /// be parsed.
   @override
   MediaInformation? getMediaInformation() {
+    final cached = _mediaInformation;
+    if (cached != null) return cached;
     FFmpegKitExtended.requireInitialized();
+    return _mediaInformation =
+        _parseOutput(getOutput()) ?? _readNativeMediaInformation();
+  }
+
+  /// Decodes the ffprobe JSON document in [output], or returns `null` if
+  /// [output] does not hold one.
+  static MediaInformation? _parseOutput(String? output) {
+    if (output == null) return null;
+    // `-v error` diagnostics may precede the document.
+    final start = output.indexOf('{');
+    if (start < 0) return null;
+    try {
+      final json = jsonDecode(output.substring(start));
+      if (json is! Map<String, dynamic> || !json.containsKey('format')) {
+        return null;
+      }
+      return MediaInformation.fromFFprobeJson(json);
+    } on FormatException {
+      return null;
+    }
+  }
+
+  MediaInformation? _readNativeMediaInformation() {
     final mediaInfoHandle = ffmpeg
         .media_information_session_get_media_information(handle);
     if (mediaInfoHandle == nullptr) return null;
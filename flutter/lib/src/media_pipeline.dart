@@ -0,0 +1,552 @@
+/*
+ * FFmpegKit Flutter Extended Plugin - A wrapper library for FFmpeg
+ * Copyright (C) 2026 Akash Patel
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+import 'dart:async';
+import 'dart:collection';
+import 'dart:developer';
+
+import 'ffmpeg_session.dart';
+import 'media_information.dart';
+import 'media_information_session.dart';
+import 'session.dart';
+import 'session_queue_manager.dart';
+
+/// Body of a [PipelineStage].
+///
+/// Receives a [PipelineContext] exposing the results of every upstream stage
+/// and returns the stage's own [PipelineStageResult].  Throwing marks the stage
+/// as failed and cancels every stage that depends on it.
+typedef PipelineStageRunner =
+    Future<PipelineStageResult> Function(PipelineContext context);
+
+/// Builds an FFmpeg argument list from upstream stage results.
+typedef PipelineArgumentsBuilder =
+    List<String> Function(PipelineContext context);
+
+/// Final state of a stage after [MediaPipeline.run] returns.
+enum PipelineStageStatus { succeeded, failed, cancelled }
+
+/// Output of a single pipeline stage, passed to downstream stages.
+class PipelineStageResult {
+  /// Files produced by the stage, in declaration order.
+  final List<String> outputs;
+
+  /// Parsed media information, populated by probe stages.
+  final MediaInformation? mediaInformation;
+
+  /// The session that executed the stage, if any.
+  final Session? session;
+
+  /// Arbitrary values a custom stage wants to expose downstream.
+  final Map<String, Object?> values;
+
+  /// Creates a new [PipelineStageResult].
+  const PipelineStageResult({
+    this.outputs = const [],
+    this.mediaInformation,
+    this.session,
+    this.values = const {},
+  });
+}
+
+/// Read-only view of upstream results handed to a running stage.
+class PipelineContext {
+  final Map<String, PipelineStageResult> _results;
+  final MediaPipeline _pipeline;
+
+  PipelineContext._(this._pipeline, this._results);
+
+  /// Results of every stage that has completed successfully so far.
+  Map<String, PipelineStageResult> get results =>
+      UnmodifiableMapView(_results);
+
+  /// Returns the result of [stageId].
+  ///
+  /// Throws [StateError] if the stage has not completed successfully, which
+  /// indicates a missing entry in [PipelineStage.dependsOn].
+  PipelineStageResult resultOf(String stageId) {
+    final result = _results[stageId];
+    if (result == null) {
+      throw StateError(
+        'Stage "$stageId" has no result; declare it in dependsOn',
+      );
+    }
+    return result;
+  }
+
+  /// Returns the first output path of [stageId].
+  String outputOf(String stageId) {
+    final outputs = resultOf(stageId).outputs;
+    if (outputs.isEmpty) {
+      throw StateError('Stage "$stageId" produced no outputs');
+    }
+    return outputs.first;
+  }
+
+  /// Returns the [MediaInformation] produced by the probe stage [stageId].
+  MediaInformation mediaInformationOf(String stageId) {
+    final info = resultOf(stageId).mediaInformation;
+    if (info == null) {
+      throw StateError('Stage "$stageId" produced no media information');
+    }
+    return info;
+  }
+
+  /// Registers [session] so that [MediaPipeline.cancel] can reach it.
+  ///
+  /// Built-in stages call this automatically; custom stages that start their
+  /// own sessions should call it before awaiting them.
+  void track(Session session) => _pipeline._track(session);
+}
+
+/// A node in a [MediaPipeline].
+class PipelineStage {
+  /// Unique identifier of this stage within its pipeline.
+  final String id;
+
+  /// Identifiers of the stages that must succeed before this one starts.
+  final List<String> dependsOn;
+
+  /// The stage body.
+  final PipelineStageRunner run;
+
+  /// Creates a stage that executes an arbitrary [run] body.
+  PipelineStage(this.id, {this.dependsOn = const [], required this.run});
+
+  /// Creates a stage that probes [path] with a [MediaInformationSession].
+  ///
+  /// The parsed [MediaInformation] is exposed to downstream stages through
+  /// [PipelineContext.mediaInformationOf]; [path] is reported as the stage
+  /// output so that transcode stages can use [PipelineContext.outputOf].
+  factory PipelineStage.probe(
+    String id,
+    String path, {
+    List<String> dependsOn = const [],
+  }) => PipelineStage(
+    id,
+    dependsOn: dependsOn,
+    run: (context) async {
+      final session = MediaInformationSession.fromPath(path);
+      context.track(session);
+      await session.executeAsync();
+      final info = session.getMediaInformation();
+      if (info == null) {
+        throw PipelineStageException(
+          id,
+          'ffprobe returned no media information for $path',
+          session: session,
+        );
+      }
+      return PipelineStageResult(
+        outputs: [path],
+        mediaInformation: info,
+        session: session,
+      );
+    },
+  );
+
+  /// Creates a stage that runs an FFmpeg command.
+  ///
+  /// [arguments] is evaluated only once every dependency has succeeded, so it
+  /// can reference upstream outputs and media information.  [outputs] lists
+  /// the files the command writes; they are forwarded to downstream stages.
+  factory PipelineStage.ffmpeg(
+    String id, {
+    required PipelineArgumentsBuilder arguments,
+    List<String> outputs = const [],
+    List<String> dependsOn = const [],
+  }) => PipelineStage(
+    id,
+    dependsOn: dependsOn,
+    run: (context) async {
+      final session = FFmpegSession.fromArguments(arguments(context));
+      context.track(session);
+      await session.executeAsync();
+      final returnCode = session.getReturnCode();
+      if (ReturnCode.isCancel(returnCode) || session.isCancelled) {
+        throw SessionCancelledException('Stage "$id" was cancelled');
+      }
+      if (!ReturnCode.isSuccess(returnCode)) {
+        throw PipelineStageException(
+          id,
+          'ffmpeg exited with code $returnCode',
+          session: session,
+        );
+      }
+      return PipelineStageResult(outputs: outputs, session: session);
+    },
+  );
+}
+
+/// Timing and outcome of a single stage.
+class PipelineStageReport {
+  /// The stage identifier.
+  final String id;
+
+  /// How the stage ended.
+  final PipelineStageStatus status;
+
+  /// Offset from pipeline start at which the stage began, or `null` if it
+  /// never started.
+  final Duration? startedAt;
+
+  /// Offset from pipeline start at which the stage ended, or `null` if it
+  /// never started.
+  final Duration? endedAt;
+
+  /// The stage result when [status] is [PipelineStageStatus.succeeded].
+  final PipelineStageResult? result;
+
+  /// The failure or cancellation cause, if any.
+  final Object? error;
+
+  PipelineStageReport._(
+    this.id,
+    this.status, {
+    this.startedAt,
+    this.endedAt,
+    this.result,
+    this.error,
+  });
+
+  /// Wall-clock time spent executing the stage.
+  Duration get duration => startedAt == null || endedAt == null
+      ? Duration.zero
+      : endedAt! - startedAt!;
+
+  @override
+  String toString() =>
+      'PipelineStageReport($id, ${status.name}, duration: $duration)';
+}
+
+/// Outcome of a [MediaPipeline.run] call.
+class PipelineResult {
+  /// Per-stage reports keyed by stage identifier.
+  final Map<String, PipelineStageReport> stages;
+
+  /// Total wall-clock time of the run.
+  final Duration elapsed;
+
+  /// Stage identifiers along the critical path, from source to sink.
+  ///
+  /// The critical path is the dependency chain that bounded end-to-end
+  /// latency: it ends at the stage that finished last and, at every step,
+  /// walks back to the dependency that finished last (the one the next stage
+  /// actually waited for).  Shortening any other stage does not reduce
+  /// [elapsed].
+  final List<String> criticalPath;
+
+  PipelineResult._(this.stages, this.elapsed, this.criticalPath);
+
+  /// Whether every stage succeeded.
+  bool get succeeded =>
+      stages.values.every((s) => s.status == PipelineStageStatus.succeeded);
+
+  /// Sum of stage durations along [criticalPath].
+  Duration get criticalPathDuration => criticalPath.fold(
+    Duration.zero,
+    (sum, id) => sum + stages[id]!.duration,
+  );
+
+  /// Returns the result of [stageId], or `null` if it did not succeed.
+  PipelineStageResult? resultOf(String stageId) => stages[stageId]?.result;
+
+  @override
+  String toString() =>
+      'PipelineResult(elapsed: $elapsed, criticalPath: ${criticalPath.join(' -> ')})';
+}
+
+/// Exception raised by built-in stages when their session fails.
+class PipelineStageException implements Exception {
+  /// The failing stage.
+  final String stageId;
+
+  /// Description of the failure.
+  final String message;
+
+  /// The session that failed, if any.
+  final Session? session;
+
+  PipelineStageException(this.stageId, this.message, {this.session});
+
+  /// Returns a string representation of this exception.
+  @override
+  String toString() => 'PipelineStageException($stageId): $message';
+}
+
+/// Runs a set of dependent media stages as a directed acyclic graph.
+///
+/// Every stage whose dependencies have succeeded is started immediately, so
+/// independent branches (e.g. transcode, thumbnail, and waveform after a probe)
+/// run concurrently.  Session-backed stages go through
+/// [SessionQueueManager.executeSession] via `executeAsync`, so the global
+/// concurrency limit still applies.
+///
+/// When a stage fails, every stage that transitively depends on it is marked
+/// [PipelineStageStatus.cancelled] without being started.  Unrelated branches
+/// keep running unless [failFast] is set, in which case running sessions are
+/// cancelled as well.
+///
+/// ```dart
+/// final result = await MediaPipeline([
+///   PipelineStage.probe('probe', input),
+///   PipelineStage.ffmpeg('transcode',
+///       dependsOn: ['probe'],
+///       arguments: (c) => ['-i', c.outputOf('probe'), '-c:v', 'libx264', out],
+///       outputs: [out]),
+///   PipelineStage.ffmpeg('thumbnail',
+///       dependsOn: ['probe'],
+///       arguments: (c) => ['-i', c.outputOf('probe'), '-frames:v', '1', thumb],
+///       outputs: [thumb]),
+/// ]).run();
+/// print(result.criticalPath);
+/// ```
+class MediaPipeline {
+  final Map<String, PipelineStage> _stages;
+
+  /// Whether a single failure cancels the entire pipeline.
+  final bool failFast;
+
+  /// Optional callback invoked as each stage reaches a final state.
+  final void Function(PipelineStageReport report)? onStageComplete;
+
+  final Set<Session> _trackedSessions = <Session>{};
+  bool _cancelled = false;
+  bool _running = false;
+
+  /// Creates a pipeline from [stages].
+  ///
+  /// Throws [ArgumentError] for duplicate identifiers, unknown dependencies,
+  /// or dependency cycles.
+  MediaPipeline(
+    List<PipelineStage> stages, {
+    this.failFast = false,
+    this.onStageComplete,
+  }) : _stages = LinkedHashMap<String, PipelineStage>() {
+    for (final stage in stages) {
+      if (_stages.containsKey(stage.id)) {
+        throw ArgumentError('Duplicate pipeline stage id "${stage.id}"');
+      }
+      _stages[stage.id] = stage;
+    }
+    for (final stage in stages) {
+      for (final dep in stage.dependsOn) {
+        if (!_stages.containsKey(dep)) {
+          throw ArgumentError(
+            'Stage "${stage.id}" depends on unknown stage "$dep"',
+          );
+        }
+      }
+    }
+    _checkAcyclic();
+  }
+
+  /// Cancels every running session and skips all stages not yet started.
+  void cancel() {
+    _cancelled = true;
+    _cancelTrackedSessions();
+  }
+
+  /// Executes the pipeline and resolves once every stage reached a final state.
+  ///
+  /// Never throws for stage failures; inspect [PipelineResult.stages] instead.
+  Future<PipelineResult> run() async {
+    if (_running) {
+      throw StateError('MediaPipeline.run is already in progress');
+    }
+    _running = true;
+    _cancelled = false;
+
+    final clock = Stopwatch()..start();
+    final pending = LinkedHashSet<String>.of(_stages.keys);
+    final running = <String, Future<void>>{};
+    final results = <String, PipelineStageResult>{};
+    final reports = <String, PipelineStageReport>{};
+    final context = PipelineContext._(this, results);
+
+    void finish(PipelineStageReport report) {
+      reports[report.id] = report;
+      try {
+        onStageComplete?.call(report);
+      } catch (e, st) {
+        log(
+          'MediaPipeline: error in onStageComplete for stage ${report.id}',
+          error: e,
+          stackTrace: st,
+        );
+      }
+    }
+
+    try {
+      while (pending.isNotEmpty || running.isNotEmpty) {
+        // Skip every pending stage that can no longer run.
+        var skipped = true;
+        while (skipped) {
+          skipped = false;
+          for (final id in pending.toList()) {
+            final blocker = _cancelled
+                ? id
+                : _stages[id]!.dependsOn.firstWhere(
+                    (dep) =>
+                        reports[dep] != null &&
+                        reports[dep]!.status != PipelineStageStatus.succeeded,
+                    orElse: () => '',
+                  );
+            if (blocker.isEmpty) continue;
+            pending.remove(id);
+            finish(
+              PipelineStageReport._(
+                id,
+                PipelineStageStatus.cancelled,
+                error: SessionCancelledException(
+                  _cancelled
+                      ? 'Pipeline was cancelled'
+                      : 'Upstream stage "$blocker" did not succeed',
+                ),
+              ),
+            );
+            skipped = true;
+          }
+        }
+
+        // Start every stage whose dependencies have all succeeded.
+        for (final id in pending.toList()) {
+          final stage = _stages[id]!;
+          if (!stage.dependsOn.every((dep) => results.containsKey(dep))) {
+            continue;
+          }
+          pending.remove(id);
+          final startedAt = clock.elapsed;
+          running[id] = Future.sync(() => stage.run(context)).then(
+            (result) {
+              results[id] = result;
+              finish(
+                PipelineStageReport._(
+                  id,
+                  PipelineStageStatus.succeeded,
+                  startedAt: startedAt,
+                  endedAt: clock.elapsed,
+                  result: result,
+                ),
+              );
+            },
+            onError: (Object e, StackTrace st) {
+              log(
+                'MediaPipeline: stage $id failed',
+                error: e,
+                stackTrace: st,
+              );
+              finish(
+                PipelineStageReport._(
+                  id,
+                  e is SessionCancelledException
+                      ? PipelineStageStatus.cancelled
+                      : PipelineStageStatus.failed,
+                  startedAt: startedAt,
+                  endedAt: clock.elapsed,
+                  error: e,
+                ),
+              );
+              if (failFast) cancel();
+            },
+          );
+        }
+
+        if (running.isEmpty) break;
+        final done = await Future.any(
+          running.entries.map((e) => e.value.then((_) => e.key)),
+        );
+        running.remove(done);
+      }
+    } finally {
+      clock.stop();
+      _trackedSessions.clear();
+      _running = false;
+    }
+
+    return PipelineResult._(
+      Map.unmodifiable(reports),
+      clock.elapsed,
+      _criticalPath(reports),
+    );
+  }
+
+  void _track(Session session) {
+    _trackedSessions.add(session);
+    if (_cancelled) _cancelTrackedSessions();
+  }
+
+  void _cancelTrackedSessions() {
+    for (final session in _trackedSessions.toList()) {
+      try {
+        session.cancel();
+      } catch (e, st) {
+        log(
+          'MediaPipeline: error cancelling session ${session.sessionId}',
+          error: e,
+          stackTrace: st,
+        );
+      }
+    }
+  }
+
+  List<String> _criticalPath(Map<String, PipelineStageReport> reports) {
+    PipelineStageReport? latest(Iterable<String> ids) {
+      PipelineStageReport? best;
+      for (final id in ids) {
+        final report = reports[id];
+        if (report?.endedAt == null) continue;
+        if (best == null || report!.endedAt! > best.endedAt!) best = report;
+      }
+      return best;
+    }
+
+    final path = <String>[];
+    var current = latest(reports.keys);
+    while (current != null) {
+      path.add(current.id);
+      current = latest(_stages[current.id]!.dependsOn);
+    }
+    return path.reversed.toList(growable: false);
+  }
+
+  void _checkAcyclic() {
+    final inDegree = {
+      // Distinct dependencies: a stage may list the same one twice.
+      for (final stage in _stages.values)
+        stage.id: stage.dependsOn.toSet().length,
+    };
+    final queue = Queue<String>.of(
+      inDegree.entries.where((e) => e.value == 0).map((e) => e.key),
+    );
+    var visited = 0;
+    while (queue.isNotEmpty) {
+      final id = queue.removeFirst();
+      visited++;
+      for (final stage in _stages.values) {
+        if (stage.dependsOn.contains(id) && --inDegree[stage.id]! == 0) {
+          queue.add(stage.id);
+        }
+      }
+    }
+    if (visited != _stages.length) {
+      throw ArgumentError('MediaPipeline stages contain a dependency cycle');
+    }
+  }
+}
@@ -0,0 +1,308 @@
+/*
+ * FFmpegKit Flutter Extended Plugin - A wrapper library for FFmpeg
+ * Copyright (C) 2026 Akash Patel
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+import 'dart:async';
+import 'dart:collection';
+import 'dart:convert';
+import 'dart:developer';
+import 'dart:io';
+import 'dart:isolate';
+
+import 'fast_probe.dart';
+import 'ffmpeg_kit_extended.dart';
+import 'media_information.dart';
+
+/// A bounded pool of background isolates dedicated to probing.
+///
+/// Each worker runs ffprobe synchronously through
+/// [FastProbe.executeSync] and parses the JSON result into
+/// [MediaInformation] on its own isolate, so bulk probes neither block the UI
+/// isolate nor go through callback registration, global log capture, or the
+/// [SessionQueueManager] shared with transcodes.
+///
+/// ```dart
+/// final pool = MediaProbePool();
+/// await for (final info in pool.probeAll(paths).handleError(
+///   (e) => print('skipped: $e'),
+/// )) {
+///   print('${info.filename}: ${info.duration}');
+/// }
+/// await pool.close();
+/// ```
+class MediaProbePool {
+  /// Number of worker isolates.
+  final int concurrency;
+
+  /// Optional `-probesize` applied to every probe.
+  final int? probeSize;
+
+  /// Optional `-analyzeduration` applied to every probe.
+  final Duration? analyzeDuration;
+
+  final List<_ProbeWorker> _idle = [];
+  final Queue<Completer<_ProbeWorker>> _waiters = Queue();
+  final List<_ProbeWorker> _all = [];
+  int _spawned = 0;
+  bool _closed = false;
+
+  /// Creates a pool with [concurrency] workers; see [defaultConcurrency].
+  MediaProbePool({int? concurrency, this.probeSize, this.analyzeDuration})
+    : concurrency = concurrency ?? defaultConcurrency(const []) {
+    if (this.concurrency < 1) {
+      throw ArgumentError.value(concurrency, 'concurrency', 'must be >= 1');
+    }
+  }
+
+  /// Picks a worker count suited to [paths].
+  ///
+  /// Local probes are bounded by CPU and disk, so the pool uses the number of
+  /// processors (at most 8).  Remote probes mostly wait on the network, so
+  /// more of them can usefully overlap.
+  static int defaultConcurrency(Iterable<String> paths) {
+    final local = Platform.numberOfProcessors.clamp(2, 8);
+    final remote = paths.where((p) => p.contains('://')).length;
+    return remote * 2 > paths.length ? 16 : local;
+  }
+
+  /// Probes every path and emits results as they complete.
+  ///
+  /// Failures are emitted as [ProbeException] errors on the stream; the
+  /// remaining paths are still probed.  Paths are submitted lazily, so
+  /// pausing the subscription stops new probes from starting.
+  ///
+  /// With [closePoolWhenDone] the pool is closed once the stream completes or
+  /// its subscription is cancelled.
+  Stream<MediaInformation> probeAll(
+    Iterable<String> paths, {
+    bool closePoolWhenDone = false,
+  }) {
+    late final StreamController<MediaInformation> controller;
+    final iterator = paths.iterator;
+    var running = 0;
+    var exhausted = false;
+
+    void finish() {
+      if (controller.isClosed) return;
+      controller.close();
+      if (closePoolWhenDone) close();
+    }
+
+    void pump() {
+      while (!exhausted &&
+          !controller.isPaused &&
+          !controller.isClosed &&
+          running < concurrency) {
+        if (!iterator.moveNext()) {
+          exhausted = true;
+          break;
+        }
+        final path = iterator.current;
+        running++;
+        probe(path)
+            .then(controller.add, onError: controller.addError)
+            .whenComplete(() {
+              running--;
+              if (exhausted && running == 0) {
+                finish();
+              } else {
+                pump();
+              }
+            });
+      }
+      if (exhausted && running == 0) finish();
+    }
+
+    controller = StreamController<MediaInformation>(
+      onListen: pump,
+      onResume: pump,
+      onCancel: () {
+        exhausted = true;
+        if (closePoolWhenDone) close();
+      },
+    );
+    return controller.stream;
+  }
+
+  /// Probes a single [path] on a pool worker.
+  ///
+  /// Throws [ProbeException] if the input cannot be opened.
+  Future<MediaInformation> probe(String path) async {
+    FFmpegKitExtended.requireInitialized();
+    final worker = await _acquire();
+    try {
+      final reply = await worker.run(buildArguments(path));
+      if (reply is MediaInformation) return reply;
+      if (reply is ProbeException) throw reply;
+      throw ProbeException(path, -1, '$reply');
+    } finally {
+      _release(worker);
+    }
+  }
+
+  /// Builds the ffprobe arguments used for [path].
+  List<String> buildArguments(String path) => [
+    '-v',
+    'error',
+    '-hide_banner',
+    if (probeSize != null) ...['-probesize', '$probeSize'],
+    if (analyzeDuration != null) ...[
+      '-analyzeduration',
+      '${analyzeDuration!.inMicroseconds}',
+    ],
+    '-print_format',
+    'json',
+    '-show_format',
+    '-show_streams',
+    '-show_chapters',
+    '-i',
+    path,
+  ];
+
+  /// Shuts down every worker isolate.
+  ///
+  /// Probes that are queued or still running fail with [StateError].
+  Future<void> close() async {
+    _closed = true;
+    for (final waiter in _waiters) {
+      waiter.completeError(StateError('MediaProbePool is closed'));
+    }
+    _waiters.clear();
+    for (final worker in _all) {
+      worker.shutdown();
+    }
+    _all.clear();
+    _idle.clear();
+  }
+
+  Future<_ProbeWorker> _acquire() async {
+    if (_closed) throw StateError('MediaProbePool is closed');
+    if (_idle.isNotEmpty) return _idle.removeLast();
+    if (_spawned < concurrency) {
+      _spawned++;
+      final _ProbeWorker worker;
+      try {
+        worker = await _ProbeWorker.spawn();
+      } catch (e, st) {
+        _spawned--;
+        log(
+          'MediaProbePool: error spawning probe worker',
+          error: e,
+          stackTrace: st,
+        );
+        rethrow;
+      }
+      _all.add(worker);
+      if (_closed) {
+        worker.shutdown();
+        throw StateError('MediaProbePool is closed');
+      }
+      return worker;
+    }
+    final waiter = Completer<_ProbeWorker>();
+    _waiters.add(waiter);
+    return waiter.future;
+  }
+
+  void _release(_ProbeWorker worker) {
+    if (_closed) {
+      worker.shutdown();
+    } else if (_waiters.isNotEmpty) {
+      _waiters.removeFirst().complete(worker);
+    } else {
+      _idle.add(worker);
+    }
+  }
+}
+
+/// A long-lived isolate that executes probes one at a time.
+class _ProbeWorker {
+  final Isolate _isolate;
+  final SendPort _commands;
+  final ReceivePort _replies;
+  Completer<Object?>? _current;
+
+  _ProbeWorker._(this._isolate, this._commands, this._replies);
+
+  static Future<_ProbeWorker> spawn() async {
+    final replies = ReceivePort();
+    final commands = Completer<SendPort>();
+    _ProbeWorker? worker;
+    // The first message is the worker's command port; later ones are replies.
+    replies.listen((message) {
+      final current = worker?._current;
+      if (worker == null) {
+        commands.complete(message as SendPort);
+        return;
+      }
+      worker!._current = null;
+      current?.complete(message);
+    });
+    final isolate = await Isolate.spawn(
+      _main,
+      replies.sendPort,
+      debugName: 'MediaProbePool',
+    );
+    return worker = _ProbeWorker._(isolate, await commands.future, replies);
+  }
+
+  Future<Object?> run(List<String> arguments) {
+    final completer = _current = Completer<Object?>();
+    _commands.send(arguments);
+    return completer.future;
+  }
+
+  /// Stops the isolate.  A probe still in flight fails with [StateError].
+  void shutdown() {
+    final current = _current;
+    _current = null;
+    current?.completeError(StateError('MediaProbePool is closed'));
+    _commands.send(null);
+    _replies.close();
+    _isolate.kill(priority: Isolate.beforeNextEvent);
+  }
+
+  static void _main(SendPort replies) {
+    final commands = ReceivePort();
+    replies.send(commands.sendPort);
+    commands.listen((message) {
+      if (message == null) {
+        commands.close();
+        return;
+      }
+      final arguments = message as List<String>;
+      final path = arguments.last;
+      try {
+        final (returnCode, output) = FastProbe.executeSync(arguments);
+        if (returnCode != 0) {
+          replies.send(ProbeException(path, returnCode, output.trim()));
+          return;
+        }
+        final json = jsonDecode(output) as Map<String, dynamic>;
+        final format = json['format'];
+        if (format is! Map || format.isEmpty) {
+          replies.send(ProbeException(path, returnCode, 'No format found'));
+          return;
+        }
+        replies.send(MediaInformation.fromFFprobeJson(json));
+      } catch (e) {
+        replies.send(ProbeException(path, -1, e.toString()));
+      }
+    });
+  }
+}
@@ -0,0 +1,159 @@
+/*
+ * FFmpegKit Flutter Extended Plugin - A wrapper library for FFmpeg
+ * Copyright (C) 2026 Akash Patel
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+/// Interpolated media clock for an FFplay session.
+///
+/// The clock holds an anchor — a media position, the wall time at which it was
+/// observed, a playback rate, and whether playback is running — and derives
+/// the current position from elapsed wall time.  Reading [position] is
+/// therefore a pure computation with no native call, cheap enough to do on
+/// every frame from a `Ticker` or `AnimationController`.
+///
+/// The anchor is moved explicitly on [pause], [resume], and [seek], and is
+/// corrected from the native player by [sync], which tolerates the jitter
+/// FFplay's clock shows around stalls and end of file:
+///
+/// * a backwards native position is ignored unless a seek is pending;
+/// * a transition from playing to stopped freezes the clock at [duration];
+/// * a NaN native position (reported while a seek is in progress) is skipped.
+///
+/// [position] never moves backwards between anchors that do not reset it, so
+/// an interpolated value that overshot the next native reading is held rather
+/// than visibly rewound.
+class PlaybackClock {
+  final Duration Function() _elapsed;
+
+  double _anchorPosition = 0.0;
+  Duration _anchorTime = Duration.zero;
+  double _rate = 1.0;
+  bool _running = false;
+  bool _seekPending = false;
+  double _duration = 0.0;
+  double _highWater = 0.0;
+
+  /// Creates a stopped clock at position zero.
+  ///
+  /// [elapsed] supplies monotonic wall time and defaults to a [Stopwatch]
+  /// started on construction; tests may pass a controllable source.
+  PlaybackClock({Duration Function()? elapsed})
+    : _elapsed = elapsed ?? _stopwatchElapsed();
+
+  /// Media duration in seconds, or `0.0` when not yet known.
+  ///
+  /// A positive duration caps [position].
+  double get duration => _duration;
+
+  set duration(double value) {
+    if (value.isNaN || value.isInfinite || value < 0) return;
+    _duration = value;
+  }
+
+  /// Playback rate applied to elapsed wall time while running.
+  double get rate => _rate;
+
+  set rate(double value) {
+    if (value.isNaN || value.isInfinite || value < 0) return;
+    _reanchor(_raw());
+    _rate = value;
+  }
+
+  /// Whether the clock is advancing.
+  bool get isRunning => _running;
+
+  /// Whether a seek was issued and the native position has not yet been
+  /// accepted by [sync].
+  bool get isSeekPending => _seekPending;
+
+  /// Current media position in seconds.
+  double get position {
+    final raw = _raw();
+    final capped = _duration > 0.0 && raw > _duration ? _duration : raw;
+    if (capped > _highWater) _highWater = capped;
+    return _highWater;
+  }
+
+  /// Re-anchors the clock at [position] and discards the high-water mark.
+  void reset(double position, {bool running = false}) {
+    if (position.isNaN) position = 0.0;
+    _reanchor(position);
+    _highWater = position;
+    _running = running;
+    _seekPending = false;
+  }
+
+  /// Stops the clock, optionally at the native [at] position.
+  void pause([double? at]) {
+    _reanchor(at == null || at.isNaN ? position : at);
+    _running = false;
+  }
+
+  /// Restarts the clock, optionally from the native [at] position.
+  void resume([double? at]) {
+    _reanchor(at == null || at.isNaN ? position : at);
+    _running = true;
+  }
+
+  /// Moves the clock to [target], which may be behind the current position.
+  void seek(double target) {
+    if (target.isNaN || target.isInfinite) return;
+    final clamped = target.clamp(0.0, _duration > 0 ? _duration : target);
+    _reanchor(clamped);
+    _highWater = clamped;
+    _seekPending = true;
+  }
+
+  /// Corrects the anchor from a native reading of [nativePosition] and the
+  /// native [playing] state.
+  void sync(double nativePosition, bool playing) {
+    // During a seek the native clock is undefined; FFplay reports nan.
+    if (nativePosition.isNaN) return;
+
+    final wasRunning = _running;
+    _running = playing;
+    if (wasRunning && !playing && !_seekPending) {
+      // Playback just ended.  The native context may already have reset to 0;
+      // freeze at duration so the UI lands on the final frame, not the start.
+      _reanchor(_duration > 0.0 ? _duration : _anchorPosition);
+    } else if (_seekPending || nativePosition >= _anchorPosition) {
+      _reanchor(nativePosition);
+      if (_seekPending) _highWater = nativePosition;
+      _seekPending = false;
+    } else {
+      // Native position went backwards without a seek — clock jitter near
+      // EOF or a buffer stall.  Keep the last good anchor.
+      _reanchor(_anchorPosition);
+    }
+  }
+
+  double _raw() {
+    if (!_running) return _anchorPosition;
+    final elapsed = _elapsed() - _anchorTime;
+    return _anchorPosition + elapsed.inMicroseconds / 1e6 * _rate;
+  }
+
+  void _reanchor(double position) {
+    _anchorPosition = position;
+    _anchorTime = _elapsed();
+  }
+
+  static Duration Function() _stopwatchElapsed() {
+    final stopwatch = Stopwatch()..start();
+    return () => stopwatch.elapsed;
+  }
+}
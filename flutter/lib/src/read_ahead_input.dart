@@ -0,0 +1,282 @@
+/*
+ * FFmpegKit Flutter Extended Plugin - A wrapper library for FFmpeg
+ * Copyright (C) 2026 Akash Patel
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+import 'dart:async';
+import 'dart:collection';
+import 'dart:developer';
+import 'dart:io';
+import 'dart:typed_data';
+
+import 'package:path/path.dart' as p;
+
+import 'ffmpeg_pipe.dart';
+import 'libc.dart';
+
+/// Read-ahead counters of a [ReadAheadInput].
+class ReadAheadStatistics {
+  /// Blocks that were already prefetched when FFmpeg needed them.
+  final int hits;
+
+  /// Blocks FFmpeg had to wait for.
+  final int misses;
+
+  /// Bytes read from the source file.
+  final int bytesRead;
+
+  const ReadAheadStatistics._(this.hits, this.misses, this.bytesRead);
+
+  /// Fraction of blocks served from the read-ahead window.
+  double get hitRatio => hits + misses == 0 ? 0 : hits / (hits + misses);
+
+  @override
+  String toString() =>
+      'ReadAheadStatistics(hits: $hits, misses: $misses, bytes: $bytesRead)';
+}
+
+/// Feeds a local file to FFmpeg through a prefetching read-ahead window.
+///
+/// The demuxer's small synchronous reads are served from a window of
+/// [windowBlocks] blocks of [blockSize] bytes that a background reader keeps
+/// filled on dart:io's I/O threads, and the bytes reach FFmpeg through an
+/// [FFmpegPipeInput].  On Linux and Android the kernel is also asked
+/// (`POSIX_FADV_WILLNEED`) to start loading the data beyond the window into
+/// the page cache early.  This turns seek latency on spinning disks and
+/// network mounts into throughput, at the cost of one extra copy through the
+/// pipe.
+///
+/// A pipe cannot seek, and FFmpeg's reads through it cannot be observed as
+/// seeks, so whether an input needs random access is decided up front from
+/// its layout rather than from the demuxer's access pattern: read-ahead
+/// switches itself off for MP4/MOV files whose `moov` box follows the media
+/// data, and for callers that pass `expectSeeks` (e.g. for input `-ss`).  In
+/// that case [inputArguments] simply names the file and FFmpeg reads it
+/// directly.
+///
+/// ```dart
+/// final input = await ReadAheadInput.open('/mnt/nas/capture.ts');
+/// await FFmpegPipes.executeAsync(
+///   FFmpegSession.fromArguments([
+///     ...input.inputArguments, '-c:v', 'libx264', output,
+///   ]),
+///   inputs: input.pipeInputs,
+/// );
+/// print(input.statistics);
+/// ```
+class ReadAheadInput {
+  /// The source file.
+  final String path;
+
+  /// Size of each read from [path].
+  final int blockSize;
+
+  /// Number of blocks kept ready ahead of FFmpeg.
+  final int windowBlocks;
+
+  /// The pipe FFmpeg reads, or `null` when read-ahead is switched off.
+  final FFmpegPipeInput? pipe;
+
+  int _hits = 0;
+  int _misses = 0;
+  int _bytesRead = 0;
+
+  ReadAheadInput._(this.path, this.blockSize, this.windowBlocks, this.pipe);
+
+  /// Prepares [path] for reading, switching read-ahead off when the file
+  /// needs random access or [expectSeeks] is set.
+  static Future<ReadAheadInput> open(
+    String path, {
+    int blockSize = 1024 * 1024,
+    int windowBlocks = 8,
+    bool expectSeeks = false,
+  }) async {
+    if (blockSize <= 0 || windowBlocks <= 0) {
+      throw ArgumentError('blockSize and windowBlocks must be positive');
+    }
+    final sequential = !expectSeeks && await isSequential(path);
+    return ReadAheadInput._(
+      path,
+      blockSize,
+      windowBlocks,
+      sequential ? FFmpegPipeInput(batchSize: blockSize) : null,
+    );
+  }
+
+  /// Whether read-ahead is active.
+  bool get isEnabled => pipe != null;
+
+  /// Arguments that open this input in FFmpeg.
+  List<String> get inputArguments => ['-i', pipe?.path ?? path];
+
+  /// Pipe sources to pass to [FFmpegPipes.executeAsync]; empty when
+  /// read-ahead is switched off.
+  Map<FFmpegPipeInput, Stream<List<int>>> get pipeInputs {
+    final pipe = this.pipe;
+    return pipe == null ? const {} : {pipe: blocks()};
+  }
+
+  /// Read-ahead counters so far.
+  ReadAheadStatistics get statistics =>
+      ReadAheadStatistics._(_hits, _misses, _bytesRead);
+
+  /// Reads [path] block by block through the read-ahead window.
+  Stream<Uint8List> blocks() async* {
+    final file = await File(path).open();
+    final ready = Queue<Uint8List>();
+    Completer<void>? dataReady;
+    Completer<void>? spaceReady;
+    var finished = false;
+    var stopped = false;
+    Object? error;
+    StackTrace? errorStackTrace;
+
+    final hints = _KernelHints.open(path);
+
+    Future<void> fill() async {
+      var offset = 0;
+      try {
+        while (!stopped) {
+          if (ready.length >= windowBlocks) {
+            await (spaceReady = Completer<void>()).future;
+            continue;
+          }
+          hints?.willNeed(offset + windowBlocks * blockSize, blockSize);
+          final block = await file.read(blockSize);
+          if (block.isEmpty) break;
+          offset += block.length;
+          _bytesRead += block.length;
+          ready.add(block);
+          dataReady?.complete();
+          dataReady = null;
+        }
+      } catch (e, st) {
+        error = e;
+        errorStackTrace = st;
+      } finally {
+        finished = true;
+        dataReady?.complete();
+        dataReady = null;
+      }
+    }
+
+    final filling = fill();
+    try {
+      while (true) {
+        if (ready.isEmpty) {
+          if (finished) break;
+          _misses++;
+          await (dataReady = Completer<void>()).future;
+          if (ready.isEmpty) break;
+        } else {
+          _hits++;
+        }
+        final block = ready.removeFirst();
+        spaceReady?.complete();
+        spaceReady = null;
+        yield block;
+      }
+      final e = error;
+      if (e != null) Error.throwWithStackTrace(e, errorStackTrace!);
+    } finally {
+      stopped = true;
+      spaceReady?.complete();
+      spaceReady = null;
+      await filling;
+      hints?.close();
+      await file.close();
+    }
+  }
+
+  /// Whether [path] can be demuxed without seeking.
+  ///
+  /// Only the ISO-BMFF family needs a check: such a file is sequential when
+  /// its `moov` box precedes the media data.
+  static Future<bool> isSequential(String path) async {
+    const isoExtensions = {'.mp4', '.m4a', '.m4v', '.mov', '.3gp', '.3g2'};
+    final RandomAccessFile file;
+    try {
+      file = await File(path).open();
+    } on FileSystemException {
+      return false;
+    }
+    try {
+      final length = await file.length();
+      var offset = 0;
+      for (var boxes = 0; boxes < 64 && offset + 8 <= length; boxes++) {
+        await file.setPosition(offset);
+        final header = await file.read(16);
+        if (header.length < 8) break;
+        final view = ByteData.sublistView(header);
+        final type = String.fromCharCodes(header, 4, 8);
+        if (boxes == 0 &&
+            type != 'ftyp' &&
+            !isoExtensions.contains(p.extension(path).toLowerCase())) {
+          return true;
+        }
+        if (type == 'moov') return true;
+        if (type == 'mdat') return false;
+        final size32 = view.getUint32(0);
+        final size = size32 == 1 && header.length == 16
+            ? view.getUint64(8)
+            : size32;
+        if (size < 8) break;
+        offset += size;
+      }
+      return false;
+    } catch (e, st) {
+      log(
+        'ReadAheadInput.isSequential: error reading $path',
+        error: e,
+        stackTrace: st,
+      );
+      return false;
+    } finally {
+      await file.close();
+    }
+  }
+}
+
+/// Page-cache hints for a file, where the platform supports them.
+///
+/// The hints go through a descriptor of their own.  That is enough for
+/// `WILLNEED`, which acts on the shared page cache; per-descriptor advice
+/// such as `SEQUENTIAL` would not reach the file dart:io reads, so it is not
+/// offered.
+class _KernelHints {
+  final int _fd;
+
+  _KernelHints._(this._fd);
+
+  static _KernelHints? open(String path) {
+    if (!Platform.isLinux && !Platform.isAndroid) return null;
+    try {
+      final fd = LibC.instance.openReadOnly(path);
+      return fd < 0 ? null : _KernelHints._(fd);
+    } catch (_) {
+      return null;
+    }
+  }
+
+  void willNeed(int offset, int length) =>
+      _advise(offset, length, LibC.fadviseWillNeed);
+
+  void _advise(int offset, int length, int advice) =>
+      LibC.instance.fadvise?.call(_fd, offset, length, advice);
+
+  void close() => LibC.instance.close(_fd);
+}
@@ -17,6 +17,7 @@
  * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
  */
 
+import 'dart:collection';
 import 'dart:convert';
 
 /// Represents a media stream within a container format.
@@ -79,24 +80,16 @@ class StreamInformation {
   final String? allPropertiesJson;
 
   /// Parsed map of tags from keys to values.
-  Map<String, dynamic>? get tags {
-    if (tagsJson == null || tagsJson!.isEmpty) return null;
-    try {
-      return jsonDecode(tagsJson!);
-    } catch (_) {
-      return null;
-    }
-  }
+  ///
+  /// Only [tagsJson] is retained; it is decoded on first access into a
+  /// read-only map.
+  late final Map<String, dynamic>? tags = _decodeObject(tagsJson);
 
   /// Parsed map of all properties from keys to values.
-  Map<String, dynamic>? get allProperties {
-    if (allPropertiesJson == null || allPropertiesJson!.isEmpty) return null;
-    try {
-      return jsonDecode(allPropertiesJson!);
-    } catch (_) {
-      return null;
-    }
-  }
+  ///
+  /// Decoded from [allPropertiesJson] on first access, like [tags].
+  late final Map<String, dynamic>? allProperties =
+      _decodeObject(allPropertiesJson);
 
   /// Creates a new [StreamInformation] instance with the given metadata.
   StreamInformation({
@@ -121,6 +114,57 @@ class StreamInformation {
     this.allPropertiesJson,
   });
 
+  /// Creates a [StreamInformation] from a map produced by [toJson].
+  factory StreamInformation.fromJson(Map<String, dynamic> json) =>
+      StreamInformation(
+        index: json['index'] as int?,
+        type: json['type'] as String?,
+        codec: json['codec'] as String?,
+        codecLong: json['codecLong'] as String?,
+        format: json['format'] as String?,
+        width: json['width'] as int?,
+        height: json['height'] as int?,
+        bitrate: json['bitrate'] as String?,
+        sampleRate: json['sampleRate'] as String?,
+        sampleFormat: json['sampleFormat'] as String?,
+        channelLayout: json['channelLayout'] as String?,
+        sampleAspectRatio: json['sampleAspectRatio'] as String?,
+        displayAspectRatio: json['displayAspectRatio'] as String?,
+        averageFrameRate: json['averageFrameRate'] as String?,
+        realFrameRate: json['realFrameRate'] as String?,
+        timeBase: json['timeBase'] as String?,
+        codecTimeBase: json['codecTimeBase'] as String?,
+        tagsJson: json['tagsJson'] as String?,
+        allPropertiesJson: json['allPropertiesJson'] as String?,
+      );
+
+  /// Creates a [StreamInformation] from one entry of ffprobe's JSON
+  /// `streams` array.
+  factory StreamInformation.fromFFprobeJson(Map<String, dynamic> json) {
+    final tags = json['tags'];
+    return StreamInformation(
+      index: json['index'] as int?,
+      type: json['codec_type'] as String?,
+      codec: json['codec_name'] as String?,
+      codecLong: json['codec_long_name'] as String?,
+      format: json['pix_fmt'] as String?,
+      width: json['width'] as int?,
+      height: json['height'] as int?,
+      bitrate: json['bit_rate'] as String?,
+      sampleRate: json['sample_rate'] as String?,
+      sampleFormat: json['sample_fmt'] as String?,
+      channelLayout: json['channel_layout'] as String?,
+      sampleAspectRatio: json['sample_aspect_ratio'] as String?,
+      displayAspectRatio: json['display_aspect_ratio'] as String?,
+      averageFrameRate: json['avg_frame_rate'] as String?,
+      realFrameRate: json['r_frame_rate'] as String?,
+      timeBase: json['time_base'] as String?,
+      codecTimeBase: json['codec_time_base'] as String?,
+      tagsJson: tags == null ? null : jsonEncode(tags),
+      allPropertiesJson: jsonEncode(json),
+    );
+  }
+
   /// Returns a string representation of this stream information.
   @override
   String toString() =>
@@ -148,4 +192,13 @@ class StreamInformation {
         'tagsJson': tagsJson,
         'allPropertiesJson': allPropertiesJson,
       };
+
+  static Map<String, dynamic>? _decodeObject(String? json) {
+    if (json == null || json.isEmpty) return null;
+    try {
+      return UnmodifiableMapView(jsonDecode(json) as Map<String, dynamic>);
+    } catch (_) {
+      return null;
+    }
+  }
 }
@@ -0,0 +1,368 @@
+/*
+ * FFmpegKit Flutter Extended Plugin - A wrapper library for FFmpeg
+ * Copyright (C) 2026 Akash Patel
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+import 'dart:async';
+import 'dart:convert';
+import 'dart:developer';
+import 'dart:io';
+
+import 'package:crypto/crypto.dart';
+import 'package:path/path.dart' as p;
+
+import 'callback_manager.dart';
+import 'ffmpeg_kit_extended.dart';
+import 'ffmpeg_session.dart';
+import 'file_identity.dart';
+import 'session.dart';
+
+/// Outcome of a [TranscodeCache] request.
+class TranscodeCacheResult {
+  /// Cache key derived from the inputs and normalised arguments.
+  final String key;
+
+  /// Whether the output was served from the cache without running FFmpeg.
+  final bool hit;
+
+  /// Path the caller asked the output to be written to.
+  final String outputPath;
+
+  /// The session that produced the output, or `null` for a cache hit.
+  ///
+  /// Requests coalesced onto an in-flight session share that session.
+  final FFmpegSession? session;
+
+  const TranscodeCacheResult._(
+    this.key,
+    this.hit,
+    this.outputPath,
+    this.session,
+  );
+
+  /// Whether [outputPath] holds a valid output.
+  bool get isSuccess {
+    if (hit) return true;
+    final session = this.session;
+    return session != null && ReturnCode.isSuccess(session.getReturnCode());
+  }
+
+  @override
+  String toString() =>
+      'TranscodeCacheResult($key, hit: $hit, output: $outputPath)';
+}
+
+/// Content-addressed cache of FFmpeg outputs.
+///
+/// Requests are keyed by a SHA-256 of the normalised argument list in which
+/// the output path is replaced by a placeholder and every local input file is
+/// replaced by its identity: path, size, and modification time by default, or
+/// a hash of its content when [hashInputContent] is set.  Identical requests
+/// therefore map to the same key even when they write to different paths.
+///
+/// Outputs are stored in [directory] and evicted least-recently-used first
+/// once their total size exceeds [maxSizeBytes].  Concurrent identical
+/// requests coalesce onto a single running session.
+///
+/// ```dart
+/// final cache = TranscodeCache(directory: '${tmp.path}/transcodes');
+/// final result = await cache.executeAsync(
+///   '-i $input -vf scale=640:-2 -c:v libx264 $output',
+///   outputPath: output,
+/// );
+/// print(result.hit ? 'served from cache' : 'transcoded');
+/// ```
+class TranscodeCache {
+  /// Directory holding cached outputs and the index.
+  final String directory;
+
+  /// Upper bound on the total size of cached outputs.
+  final int maxSizeBytes;
+
+  /// Whether input files are identified by a hash of their content instead
+  /// of path, size, and modification time.
+  final bool hashInputContent;
+
+  static const String _outputPlaceholder = '\u0000output';
+  static const String _indexFileName = 'index.json';
+
+  final Map<String, Future<TranscodeCacheResult>> _inFlight = {};
+
+  /// LRU index: key → entry, ordered from least to most recently used.
+  Map<String, _CacheEntry>? _index;
+  Future<void> _indexWrite = Future.value();
+
+  /// Creates a cache rooted at [directory].
+  TranscodeCache({
+    required this.directory,
+    this.maxSizeBytes = 1024 * 1024 * 1024,
+    this.hashInputContent = false,
+  });
+
+  /// Total size of the cached outputs in bytes.
+  Future<int> get sizeBytes async => (await _loadIndex()).values.fold<int>(
+    0,
+    (sum, entry) => sum + entry.size,
+  );
+
+  /// Runs [command] unless an identical request is cached.
+  ///
+  /// [outputPath] must appear verbatim in the parsed [command]; it is
+  /// replaced by a cache location while FFmpeg runs and receives a copy of
+  /// the cached output afterwards.
+  Future<TranscodeCacheResult> executeAsync(
+    String command, {
+    required String outputPath,
+    FFmpegLogCallback? logCallback,
+    FFmpegStatisticsCallback? statisticsCallback,
+  }) => executeWithArgumentsAsync(
+    FFmpegKitExtended.parseArguments(command),
+    outputPath: outputPath,
+    logCallback: logCallback,
+    statisticsCallback: statisticsCallback,
+  );
+
+  /// Argument-list variant of [executeAsync].
+  Future<TranscodeCacheResult> executeWithArgumentsAsync(
+    List<String> arguments, {
+    required String outputPath,
+    FFmpegLogCallback? logCallback,
+    FFmpegStatisticsCallback? statisticsCallback,
+  }) async {
+    final outputIndex = arguments.lastIndexOf(outputPath);
+    if (outputIndex < 0) {
+      throw ArgumentError.value(
+        outputPath,
+        'outputPath',
+        'does not appear in the argument list',
+      );
+    }
+
+    final key = await computeKey(arguments, outputPath);
+    final inFlight = _inFlight[key];
+    if (inFlight != null) {
+      final shared = await inFlight;
+      if (shared.isSuccess && !await _copyOut(key, outputPath)) {
+        // Evicted before this waiter could copy it; treat as a miss.
+        return executeWithArgumentsAsync(
+          arguments,
+          outputPath: outputPath,
+          logCallback: logCallback,
+          statisticsCallback: statisticsCallback,
+        );
+      }
+      return TranscodeCacheResult._(
+        key,
+        shared.hit,
+        outputPath,
+        shared.session,
+      );
+    }
+
+    final future = _resolve(
+      key,
+      arguments,
+      outputIndex,
+      outputPath,
+      logCallback,
+      statisticsCallback,
+    );
+    _inFlight[key] = future;
+    try {
+      return await future;
+    } finally {
+      _inFlight.remove(key);
+    }
+  }
+
+  /// Computes the cache key for [arguments] writing to [outputPath].
+  Future<String> computeKey(List<String> arguments, String outputPath) async {
+    final normalised = <String>[];
+    for (var i = 0; i < arguments.length; i++) {
+      final arg = arguments[i];
+      if (arg == outputPath && i == arguments.lastIndexOf(outputPath)) {
+        normalised.add(_outputPlaceholder);
+      } else if (i > 0 && arguments[i - 1] == '-i') {
+        normalised.add(
+          await fileIdentity(arg, hashContent: hashInputContent) ?? arg,
+        );
+      } else {
+        normalised.add(arg);
+      }
+    }
+    // Keep the extension so that the muxer choice remains part of the key.
+    normalised.add(p.extension(outputPath).toLowerCase());
+    return sha256.convert(utf8.encode(normalised.join('\u0000'))).toString();
+  }
+
+  /// Removes every cached output.
+  Future<void> clear() async {
+    final index = await _loadIndex();
+    for (final key in index.keys.toList()) {
+      await _deleteEntry(index, key);
+    }
+    await _saveIndex();
+  }
+
+  Future<TranscodeCacheResult> _resolve(
+    String key,
+    List<String> arguments,
+    int outputIndex,
+    String outputPath,
+    FFmpegLogCallback? logCallback,
+    FFmpegStatisticsCallback? statisticsCallback,
+  ) async {
+    final index = await _loadIndex();
+    final entry = index.remove(key);
+    if (entry != null &&
+        await File(_entryPath(key, entry.extension)).exists()) {
+      index[key] = entry..lastAccess = DateTime.now().millisecondsSinceEpoch;
+      await _saveIndex();
+      if (await _copyOut(key, outputPath)) {
+        return TranscodeCacheResult._(key, true, outputPath, null);
+      }
+      index.remove(key);
+    }
+
+    final extension = p.extension(outputPath);
+    final partial = '${_entryPath(key, extension)}.partial$extension';
+    final session = await FFmpegSession.fromArguments(
+      [...arguments]..[outputIndex] = partial,
+      logCallback: logCallback,
+      statisticsCallback: statisticsCallback,
+    ).executeAsync();
+
+    final partialFile = File(partial);
+    if (!ReturnCode.isSuccess(session.getReturnCode()) ||
+        !await partialFile.exists()) {
+      if (await partialFile.exists()) await partialFile.delete();
+      return TranscodeCacheResult._(key, false, outputPath, session);
+    }
+
+    final stored = await partialFile.rename(_entryPath(key, extension));
+    index[key] = _CacheEntry(
+      await stored.length(),
+      DateTime.now().millisecondsSinceEpoch,
+      extension,
+    );
+    await _evict(index);
+    await _saveIndex();
+    await _copyOut(key, outputPath, stored);
+    return TranscodeCacheResult._(key, false, outputPath, session);
+  }
+
+  String _entryPath(String key, String extension) =>
+      p.join(directory, '$key$extension');
+
+  /// Copies the cached output of [key] to [outputPath], or returns `false`
+  /// if the entry has been evicted.
+  Future<bool> _copyOut(String key, String outputPath, [File? source]) async {
+    if (source == null) {
+      final entry = (await _loadIndex())[key];
+      if (entry == null) return false;
+      source = File(_entryPath(key, entry.extension));
+    }
+    if (p.equals(source.path, outputPath)) return true;
+    await File(outputPath).parent.create(recursive: true);
+    try {
+      await source.copy(outputPath);
+    } on PathNotFoundException {
+      return false;
+    }
+    return true;
+  }
+
+  Future<void> _evict(Map<String, _CacheEntry> index) async {
+    var total = index.values.fold<int>(0, (sum, e) => sum + e.size);
+    for (final key in index.keys.toList()) {
+      if (total <= maxSizeBytes || index.length <= 1) break;
+      if (_inFlight.containsKey(key)) continue;
+      total -= index[key]!.size;
+      await _deleteEntry(index, key);
+    }
+  }
+
+  Future<void> _deleteEntry(Map<String, _CacheEntry> index, String key) async {
+    final entry = index.remove(key);
+    if (entry == null) return;
+    try {
+      await File(_entryPath(key, entry.extension)).delete();
+    } on FileSystemException catch (e, st) {
+      log(
+        'TranscodeCache: error deleting cached output $key',
+        error: e,
+        stackTrace: st,
+      );
+    }
+  }
+
+  Future<Map<String, _CacheEntry>> _loadIndex() async {
+    final loaded = _index;
+    if (loaded != null) return loaded;
+    await Directory(directory).create(recursive: true);
+    final entries = <MapEntry<String, _CacheEntry>>[];
+    final file = File(p.join(directory, _indexFileName));
+    if (await file.exists()) {
+      try {
+        final json = jsonDecode(await file.readAsString()) as Map;
+        json.forEach((key, value) {
+          entries.add(MapEntry(key as String, _CacheEntry.fromJson(value)));
+        });
+      } catch (e, st) {
+        log(
+          'TranscodeCache: error reading index, starting empty',
+          error: e,
+          stackTrace: st,
+        );
+      }
+    }
+    entries.sort((a, b) => a.value.lastAccess.compareTo(b.value.lastAccess));
+    return _index ??= Map.fromEntries(entries);
+  }
+
+  Future<void> _saveIndex() {
+    final json = jsonEncode({
+      for (final e in _index!.entries) e.key: e.value.toJson(),
+    });
+    // Serialise writes; each one replaces the index atomically.
+    return _indexWrite = _indexWrite.then((_) async {
+      final tmp = File(p.join(directory, '$_indexFileName.tmp'));
+      await tmp.writeAsString(json, flush: true);
+      await tmp.rename(p.join(directory, _indexFileName));
+    });
+  }
+}
+
+class _CacheEntry {
+  final int size;
+  int lastAccess;
+  final String extension;
+
+  _CacheEntry(this.size, this.lastAccess, this.extension);
+
+  factory _CacheEntry.fromJson(dynamic json) => _CacheEntry(
+    json['size'] as int,
+    json['lastAccess'] as int,
+    json['extension'] as String,
+  );
+
+  Map<String, dynamic> toJson() => {
+    'size': size,
+    'lastAccess': lastAccess,
+    'extension': extension,
+  };
+}
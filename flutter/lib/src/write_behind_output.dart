@@ -0,0 +1,201 @@
+/*
+ * FFmpegKit Flutter Extended Plugin - A wrapper library for FFmpeg
+ * Copyright (C) 2026 Akash Patel
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA
+ */
+
+import 'dart:async';
+import 'dart:collection';
+import 'dart:developer';
+import 'dart:io';
+import 'dart:typed_data';
+
+import 'package:meta/meta.dart';
+
+import 'ffmpeg_pipe.dart';
+
+/// Decouples FFmpeg's muxer from slow output storage.
+///
+/// FFmpeg writes to an [FFmpegPipeOutput], which only ever blocks on pipe
+/// capacity, while the bytes are gathered into [blockSize] blocks (a
+/// multiple of the page size) and written to [destination] on dart:io's I/O
+/// threads.  Up to [maxQueuedBlocks] blocks may wait for storage; beyond that
+/// the pipe stops being read and the muxer waits, so memory stays bounded.
+/// With [syncInterval] set, the file is flushed to the device after roughly
+/// that many bytes instead of relying on a single sync at close.
+///
+/// Write errors stop reading the pipe, which fails the session, and are
+/// reported through [done]:
+///
+/// ```dart
+/// final output = WriteBehindOutput('/mnt/nas/recording.ts');
+/// final session = await FFmpegPipes.executeAsync(
+///   FFmpegSession.fromArguments([
+///     '-i', input, '-c:v', 'libx264',
+///     ...output.outputArguments('mpegts'),
+///   ]),
+///   outputs: [output.pipe],
+/// );
+/// await output.done; // throws if the storage failed
+/// ```
+///
+/// The pipe is not seekable, so use a streamable format (MPEG-TS, Matroska,
+/// fragmented MP4) rather than a regular MP4.
+class WriteBehindOutput {
+  /// Destination file.
+  final String destination;
+
+  /// Size of each write issued to [destination].
+  final int blockSize;
+
+  /// Number of full blocks that may wait for storage.
+  final int maxQueuedBlocks;
+
+  /// Bytes between device flushes, or `null` to flush only when closing.
+  final int? syncInterval;
+
+  /// The pipe FFmpeg writes to; pass it to [FFmpegPipes.executeAsync].
+  final FFmpegPipeOutput pipe;
+
+  /// Completes with the number of bytes written once [destination] is
+  /// closed, or with the error that stopped writing.
+  late final Future<int> done = writeStream(
+    pipe.stream,
+    destination,
+    blockSize: blockSize,
+    maxQueuedBlocks: maxQueuedBlocks,
+    syncInterval: syncInterval,
+  );
+
+  /// Creates a new [WriteBehindOutput] and starts draining its pipe.
+  WriteBehindOutput(
+    this.destination, {
+    this.blockSize = 4 * 1024 * 1024,
+    this.maxQueuedBlocks = 4,
+    this.syncInterval,
+  }) : pipe = FFmpegPipeOutput() {
+    if (blockSize <= 0 || blockSize % 4096 != 0) {
+      throw ArgumentError.value(
+        blockSize,
+        'blockSize',
+        'must be a positive multiple of 4096',
+      );
+    }
+    // Surface failures through [done] only; reading must start right away.
+    done.ignore();
+  }
+
+  /// Output arguments writing [format] to [pipe].
+  List<String> outputArguments(String format) => ['-f', format, pipe.path];
+
+  /// Writes [source] to [destination] in [blockSize] blocks through a queue
+  /// of at most [maxQueuedBlocks], and returns the number of bytes written.
+  @visibleForTesting
+  static Future<int> writeStream(
+    Stream<List<int>> source,
+    String destination, {
+    int blockSize = 4 * 1024 * 1024,
+    int maxQueuedBlocks = 4,
+    int? syncInterval,
+  }) async {
+    final file = await File(destination).open(mode: FileMode.writeOnly);
+    final queue = Queue<Uint8List>();
+    final pending = BytesBuilder(copy: false);
+    final finished = Completer<int>();
+    var written = 0;
+    var sinceSync = 0;
+    var writing = false;
+    var sourceDone = false;
+    late final StreamSubscription<List<int>> subscription;
+
+    Future<void> fail(Object e, StackTrace st) async {
+      if (finished.isCompleted) return;
+      log(
+        'WriteBehindOutput: error writing $destination',
+        error: e,
+        stackTrace: st,
+      );
+      await subscription.cancel();
+      try {
+        await file.close();
+      } on FileSystemException catch (_) {}
+      finished.completeError(e, st);
+    }
+
+    Future<void> drain() async {
+      if (writing) return;
+      writing = true;
+      try {
+        while (queue.isNotEmpty) {
+          final block = queue.removeFirst();
+          if (subscription.isPaused && queue.length < maxQueuedBlocks) {
+            subscription.resume();
+          }
+          await file.writeFrom(block);
+          written += block.length;
+          sinceSync += block.length;
+          if (syncInterval != null && sinceSync >= syncInterval) {
+            sinceSync = 0;
+            await file.flush();
+          }
+        }
+        if (sourceDone && !finished.isCompleted) {
+          await file.flush();
+          await file.close();
+          finished.complete(written);
+        }
+      } catch (e, st) {
+        await fail(e, st);
+      } finally {
+        writing = false;
+      }
+    }
+
+    void enqueue(Uint8List block) {
+      queue.add(block);
+      if (queue.length >= maxQueuedBlocks && !subscription.isPaused) {
+        subscription.pause();
+      }
+      drain();
+    }
+
+    subscription = source.listen(
+      (chunk) {
+        pending.add(chunk is Uint8List ? chunk : Uint8List.fromList(chunk));
+        if (pending.length < blockSize) return;
+        final bytes = pending.takeBytes();
+        var offset = 0;
+        for (; offset + blockSize <= bytes.length; offset += blockSize) {
+          enqueue(Uint8List.sublistView(bytes, offset, offset + blockSize));
+        }
+        if (offset < bytes.length) {
+          pending.add(Uint8List.sublistView(bytes, offset));
+        }
+      },
+      onError: fail,
+      onDone: () {
+        sourceDone = true;
+        if (pending.isNotEmpty) {
+          enqueue(pending.takeBytes());
+        } else {
+          drain();
+        }
+      },
+      cancelOnError: true,
+    );
+    return finished.future;
+  }
+}
@@ -6,10 +6,16 @@
 #include <gtk/gtk.h>
 #include <GLES3/gl3.h>
 #include <dlfcn.h>
+#include <cmath>
+#include <cstdlib>
+#include <iterator>
+#include <list>
+#include <map>
 #include <mutex>
 #include <string>
 #include <vector>
 #include <cstring>
+#include <deque>
 #include <algorithm>
 #include <thread>
 #include <iomanip>
@@ -47,9 +53,11 @@ typedef void (*FFplayKitFrameCallback)(void* userdata, const uint8_t* pixels,
                                        const char* format);
 typedef void (*RegisterFrameCallbackFn)(FFplayKitFrameCallback, void*);
 typedef void (*UnregisterFrameCallbackFn)();
+typedef double (*GetPositionFn)();
 
 static RegisterFrameCallbackFn g_register_fn = nullptr;
 static UnregisterFrameCallbackFn g_unregister_fn = nullptr;
+static GetPositionFn g_get_position_fn = nullptr;
 static bool g_symbols_resolved = false;
 
 static void ResolveFFplayProcs() {
@@ -59,19 +67,22 @@ static void ResolveFFplayProcs() {
       dlsym(RTLD_DEFAULT, "ffplay_kit_register_frame_callback"));
   g_unregister_fn = reinterpret_cast<UnregisterFrameCallbackFn>(
       dlsym(RTLD_DEFAULT, "ffplay_kit_unregister_frame_callback"));
+  g_get_position_fn = reinterpret_cast<GetPositionFn>(
+      dlsym(RTLD_DEFAULT, "ffplay_kit_get_position"));
   
-  if (!g_register_fn || !g_unregister_fn) {
+  if (!g_register_fn || !g_unregister_fn || !g_get_position_fn) {
     const char* libs[] = { "libffmpegkit.so", "libffmpegkit.so.0", "libffmpegkit.so.1", nullptr};
     for (int i = 0; libs[i]; ++i) {
       void* h = dlopen(libs[i], RTLD_LAZY | RTLD_NOLOAD);
       if (!h) continue;
       if (!g_register_fn) g_register_fn = reinterpret_cast<RegisterFrameCallbackFn>(dlsym(h, "ffplay_kit_register_frame_callback"));
       if (!g_unregister_fn) g_unregister_fn = reinterpret_cast<UnregisterFrameCallbackFn>(dlsym(h, "ffplay_kit_unregister_frame_callback"));
-      if (g_register_fn && g_unregister_fn) break;
+      if (!g_get_position_fn) g_get_position_fn = reinterpret_cast<GetPositionFn>(dlsym(h, "ffplay_kit_get_position"));
+      if (g_register_fn && g_unregister_fn && g_get_position_fn) break;
     }
   }
   g_symbols_resolved = true;
-  FFKIT_LOG_T("Symbols resolved: reg=%p, unreg=%p", g_register_fn, g_unregister_fn);
+  FFKIT_LOG_T("Symbols resolved: reg=%p, unreg=%p, pos=%p", g_register_fn, g_unregister_fn, g_get_position_fn);
 }
 
 static void ffplay_kit_register_frame_callback(FFplayKitFrameCallback cb, void* ud) {
@@ -86,23 +97,209 @@ static void ffplay_kit_unregister_frame_callback() {
     g_unregister_fn(); 
 }
 
-// --- TextureState (Double-Buffered & Thread-Safe) ----------------------------
+// Master-clock position of the presented frame, or -1 when unknown (NaN
+// during a seek).
+static int64_t ffplay_kit_position_ms() {
+  ResolveFFplayProcs();
+  if (!g_get_position_fn) return -1;
+  double pos = g_get_position_fn();
+  if (std::isnan(pos) || pos < 0) return -1;
+  return static_cast<int64_t>(std::llround(pos * 1000.0));
+}
+
+// --- FrameCache (recently presented frames for scrubbing) --------------------
+// Bounded LRU of RGBA frames keyed by presentation position in milliseconds.
+// Frames may be stored downscaled; the texture simply takes the smaller size.
+// Guarded by TextureState::mutex.
+struct CachedFrame {
+  int64_t position_ms = 0;
+  uint32_t width = 0;
+  uint32_t height = 0;
+  std::vector<uint8_t> pixels;
+};
+
+struct FrameCache {
+  size_t max_bytes = 0; // 0 disables the cache
+  int downscale = 1;
+  size_t bytes = 0;
+  uint64_t hits = 0;
+  uint64_t misses = 0;
+  uint64_t evictions = 0;
+  std::list<CachedFrame> lru; // front = most recently used
+  std::map<int64_t, std::list<CachedFrame>::iterator> index;
+
+  bool enabled() const { return max_bytes > 0; }
+
+  void Configure(size_t max, int factor) {
+    max_bytes = max;
+    downscale = std::max(1, factor);
+    Clear();
+    hits = misses = evictions = 0;
+  }
+
+  void Clear() {
+    lru.clear();
+    index.clear();
+    bytes = 0;
+  }
+
+  void Insert(int64_t position_ms, const uint8_t* pixels, int width,
+              int height, int linesize) {
+    if (!enabled() || position_ms < 0) return;
+    uint32_t w = static_cast<uint32_t>(std::max(1, width / downscale));
+    uint32_t h = static_cast<uint32_t>(std::max(1, height / downscale));
+    size_t size = static_cast<size_t>(w) * h * 4;
+    if (size > max_bytes) return;
+
+    auto existing = index.find(position_ms);
+    if (existing != index.end()) {
+      bytes -= existing->second->pixels.size();
+      lru.erase(existing->second);
+      index.erase(existing);
+    }
+    while (bytes + size > max_bytes && !lru.empty()) {
+      bytes -= lru.back().pixels.size();
+      index.erase(lru.back().position_ms);
+      lru.pop_back();
+      ++evictions;
+    }
+
+    CachedFrame frame;
+    frame.position_ms = position_ms;
+    frame.width = w;
+    frame.height = h;
+    frame.pixels.resize(size);
+    for (uint32_t y = 0; y < h; ++y) {
+      const uint8_t* src = pixels + static_cast<size_t>(y) * downscale * linesize;
+      uint8_t* dst = frame.pixels.data() + static_cast<size_t>(y) * w * 4;
+      if (downscale == 1) {
+        memcpy(dst, src, static_cast<size_t>(w) * 4);
+      } else {
+        for (uint32_t x = 0; x < w; ++x) {
+          memcpy(dst + x * 4, src + static_cast<size_t>(x) * downscale * 4, 4);
+        }
+      }
+    }
+    lru.push_front(std::move(frame));
+    index[position_ms] = lru.begin();
+    bytes += size;
+  }
+
+  // Returns the frame nearest to position_ms within tolerance_ms, or nullptr.
+  const CachedFrame* Find(int64_t position_ms, int64_t tolerance_ms) {
+    auto best = index.end();
+    auto after = index.lower_bound(position_ms);
+    if (after != index.end()) best = after;
+    if (after != index.begin()) {
+      auto before = std::prev(after);
+      if (best == index.end() ||
+          position_ms - before->first < best->first - position_ms) {
+        best = before;
+      }
+    }
+    if (best == index.end() ||
+        std::llabs(best->first - position_ms) > tolerance_ms) {
+      ++misses;
+      return nullptr;
+    }
+    ++hits;
+    lru.splice(lru.begin(), lru, best->second);
+    return &*best->second;
+  }
+};
+
+// --- Presentation queue -------------------------------------------------------
+// A decoded frame waiting for the render thread, stamped with the player
+// position and the monotonic time (us) the frame callback received it.
+struct QueuedFrame {
+  std::vector<uint8_t> pixels;
+  uint32_t width = 0;
+  uint32_t height = 0;
+  int64_t position_ms = -1;
+  int64_t decoded_us = 0;
+};
+
+// Decode-to-display latency, drop, and jank counters.  A jank is a frame that
+// was decoded in time but presented more than 1.5 frame intervals after the
+// previous one; gaps caused by the decoder itself (pause, stall) don't count.
+struct PresentationStats {
+  uint64_t received = 0;
+  uint64_t presented = 0;
+  uint64_t dropped = 0;
+  uint64_t janks = 0;
+  int64_t last_latency_us = 0;
+  int64_t max_latency_us = 0;
+  int64_t total_latency_us = 0;
+  int64_t last_position_ms = -1;
+  int64_t last_arrival_us = 0;
+  int64_t last_present_us = 0;
+  double frame_interval_us = 0; // smoothed arrival interval
+
+  void OnArrival(int64_t now_us) {
+    if (last_arrival_us > 0) {
+      double interval = static_cast<double>(now_us - last_arrival_us);
+      frame_interval_us = frame_interval_us == 0
+          ? interval
+          : frame_interval_us * 0.9 + interval * 0.1;
+    }
+    last_arrival_us = now_us;
+    ++received;
+  }
+
+  void OnPresent(const QueuedFrame& frame, int64_t now_us) {
+    int64_t latency = now_us - frame.decoded_us;
+    last_latency_us = latency;
+    max_latency_us = std::max(max_latency_us, latency);
+    total_latency_us += latency;
+    double limit = frame_interval_us * 1.5;
+    if (last_present_us > 0 && limit > 0 &&
+        now_us - last_present_us > limit &&
+        frame.decoded_us - last_present_us <= limit) {
+      ++janks;
+    }
+    last_present_us = now_us;
+    last_position_ms = frame.position_ms;
+    ++presented;
+  }
+};
+
+// --- TextureState (Queued & Thread-Safe) -------------------------------------
 struct TextureState {
   FlTextureRegistrar* registrar = nullptr;
   std::mutex mutex;
   
-  std::vector<uint8_t> write_buf;
-  std::vector<uint8_t> read_buf;
+  // Frames waiting for the render thread, oldest first.  With drop_newest
+  // unset a full queue drops its oldest frame and the render thread presents
+  // the newest (lowest latency); otherwise the incoming frame is dropped so
+  // that queued frames are all presented in order.
+  std::deque<QueuedFrame> queue;
+  std::vector<std::vector<uint8_t>> spare; // recycled pixel buffers
+  size_t queue_depth = 1;
+  bool drop_newest = false;
+  bool delivering = true; // frame callback registered
   uint32_t width = 1;
   uint32_t height = 1;
   
-  bool has_pending_frame = false;
   bool destroyed = false;
   bool needs_gl_reset = false; // Deferred to render thread
   
   GLuint gl_texture_id = 0;
   int64_t fl_texture_id = 0;
   bool gl_initialized = false;
+
+  FrameCache frame_cache;
+  PresentationStats stats;
+
+  void Recycle(std::vector<uint8_t>&& buf) {
+    if (spare.size() <= queue_depth) spare.push_back(std::move(buf));
+  }
+
+  void Reset() {
+    queue.clear();
+    spare.clear();
+    frame_cache.Clear();
+    stats = PresentationStats();
+  }
 };
 
 // --- FfkitGlTexture (FlTextureGL subtype) ------------------------------------
@@ -121,6 +318,8 @@ struct _FfkitGlTextureClass {
 
 G_DEFINE_TYPE(FfkitGlTexture, ffkit_gl_texture, fl_texture_gl_get_type())
 
+static gboolean mark_frame_idle_cb(gpointer user_data);
+
 static gboolean
 ffkit_gl_texture_populate_gl_texture(FlTextureGL *texture, uint32_t *target,
                                      uint32_t *name, uint32_t *width,
@@ -135,6 +334,7 @@ ffkit_gl_texture_populate_gl_texture(FlTextureGL *texture, uint32_t *target,
   std::vector<uint8_t> upload_buf;
   uint32_t w = 1, h = 1;
   bool has_frame = false;
+  bool more_frames = false;
   bool needs_reset = false;
   bool init_gl = false;
 
@@ -164,19 +364,30 @@ ffkit_gl_texture_populate_gl_texture(FlTextureGL *texture, uint32_t *target,
       init_gl = true;
     }
 
+    // 3. Take the next frame (buffer moves, no copy): the oldest when every
+    //    frame is presented, otherwise the newest, dropping the ones behind it
+    if (!state->queue.empty()) {
+      if (!state->drop_newest) {
+        while (state->queue.size() > 1) {
+          ++state->stats.dropped;
+          state->Recycle(std::move(state->queue.front().pixels));
+          state->queue.pop_front();
+        }
+      }
+      QueuedFrame& frame = state->queue.front();
+      state->stats.OnPresent(frame, g_get_monotonic_time());
+      upload_buf.swap(frame.pixels);
+      w = state->width = frame.width;
+      h = state->height = frame.height;
+      state->queue.pop_front();
+      has_frame = true;
+      more_frames = !state->queue.empty();
+    }
+
     *target = GL_TEXTURE_2D;
     *name = state->gl_texture_id;
     *width = state->width > 0 ? state->width : 1;
     *height = state->height > 0 ? state->height : 1;
-
-    // 3. Grab frame data if available
-    if (state->has_pending_frame) {
-      upload_buf = state->read_buf; // Copy to local
-      w = state->width;
-      h = state->height;
-      has_frame = true;
-      state->has_pending_frame = false; // Mark consumed
-    }
   } // Mutex released
 
   // 4. Upload texture (outside lock to prevent blocking FFmpeg thread)
@@ -186,6 +397,17 @@ ffkit_gl_texture_populate_gl_texture(FlTextureGL *texture, uint32_t *target,
     glBindTexture(GL_TEXTURE_2D, 0);
   }
 
+  if (has_frame) {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    if (!state->destroyed) state->Recycle(std::move(upload_buf));
+  }
+
+  // 5. Frames still queued are presented on the following vsyncs
+  if (more_frames) {
+    g_object_ref(self);
+    g_idle_add(mark_frame_idle_cb, self);
+  }
+
   return TRUE;
 }
 
@@ -226,7 +448,7 @@ static gboolean mark_frame_idle_cb(gpointer user_data) {
 
   {
     std::lock_guard<std::mutex> lock(tex->state->mutex);
-    if (!tex->state->destroyed && tex->state->has_pending_frame) {
+    if (!tex->state->destroyed && !tex->state->queue.empty()) {
       should_mark = true;
       registrar = tex->state->registrar;
     }
@@ -251,27 +473,55 @@ static void on_frame_callback(void* userdata, const uint8_t* pixels, int width,
 
   bool schedule_mark = false;
 
+  // Query the player before taking the plugin lock, so the callback never
+  // re-enters ffplay while holding a lock the Dart-side getters also take.
+  int64_t now_us = g_get_monotonic_time();
+  int64_t position_ms = ffplay_kit_position_ms();
+
   {
     std::lock_guard<std::mutex> lock(state->mutex);
     if (state->destroyed) return;
 
     size_t expected_size = static_cast<size_t>(linesize) * static_cast<size_t>(height);
-    state->write_buf.assign(pixels, pixels + expected_size);
-    state->width = width;
-    state->height = height;
+    std::vector<uint8_t> buf;
+    if (!state->spare.empty()) {
+      buf = std::move(state->spare.back());
+      state->spare.pop_back();
+    }
+    buf.assign(pixels, pixels + expected_size);
 
     // Fix alpha channel for rgb0
     bool is_rgb0 = pixel_format && (strcmp(pixel_format, "rgb0") == 0);
     if (is_rgb0) {
-      uint8_t* buf = state->write_buf.data();
+      uint8_t* data = buf.data();
       size_t pixel_count = static_cast<size_t>(linesize / 4) * static_cast<size_t>(height);
       for (size_t i = 0; i < pixel_count; ++i) {
-        if (buf[i * 4 + 3] == 0) buf[i * 4 + 3] = 0xFF;
+        if (data[i * 4 + 3] == 0) data[i * 4 + 3] = 0xFF;
       }
     }
 
-    std::swap(state->write_buf, state->read_buf);
-    state->has_pending_frame = true;
+    state->stats.OnArrival(now_us);
+    if (state->frame_cache.enabled()) {
+      state->frame_cache.Insert(position_ms, buf.data(), width, height, linesize);
+    }
+
+    if (state->queue.size() >= state->queue_depth) {
+      ++state->stats.dropped;
+      if (state->drop_newest) {
+        state->Recycle(std::move(buf));
+        return;
+      }
+      state->Recycle(std::move(state->queue.front().pixels));
+      state->queue.pop_front();
+    }
+
+    QueuedFrame frame;
+    frame.pixels = std::move(buf);
+    frame.width = width;
+    frame.height = height;
+    frame.position_ms = position_ms;
+    frame.decoded_us = now_us;
+    state->queue.push_back(std::move(frame));
     schedule_mark = true;
   }
 
@@ -299,15 +549,32 @@ static void release_texture(FfmpegKitExtendedFlutterPlugin *self, int64_t textur
   {
     std::lock_guard<std::mutex> lock(self->texture->state->mutex);
     self->texture->state->destroyed = true;
-    self->texture->state->has_pending_frame = false;
-    self->texture->state->read_buf.clear();
-    self->texture->state->write_buf.clear();
+    self->texture->state->Reset();
     self->texture->state->needs_gl_reset = true; // Defer GL cleanup to render thread
   }
   // NOTE: Intentionally NOT unregistering from Flutter. Reuse same registration.
 }
 
+static void read_presentation_args(FlMethodCall* method_call, size_t* queue_depth, bool* drop_newest) {
+  FlValue* args = fl_method_call_get_args(method_call);
+  *queue_depth = 1;
+  *drop_newest = false;
+  if (!args || fl_value_get_type(args) != FL_VALUE_TYPE_MAP) return;
+  FlValue* depth = fl_value_lookup_string(args, "queueDepth");
+  if (depth && fl_value_get_type(depth) == FL_VALUE_TYPE_INT) {
+    *queue_depth = static_cast<size_t>(std::clamp<int64_t>(fl_value_get_int(depth), 1, 16));
+  }
+  FlValue* policy = fl_value_lookup_string(args, "dropPolicy");
+  if (policy && fl_value_get_type(policy) == FL_VALUE_TYPE_STRING) {
+    *drop_newest = strcmp(fl_value_get_string(policy), "dropNewest") == 0;
+  }
+}
+
 static void handle_create_texture(FfmpegKitExtendedFlutterPlugin* self, FlMethodCall* method_call) {
+  size_t queue_depth = 1;
+  bool drop_newest = false;
+  read_presentation_args(method_call, &queue_depth, &drop_newest);
+
   // Reuse existing texture if available
   if (self->texture) {
     ffplay_kit_unregister_frame_callback();
@@ -315,9 +582,10 @@ static void handle_create_texture(FfmpegKitExtendedFlutterPlugin* self, FlMethod
     {
       std::lock_guard<std::mutex> lock(self->texture->state->mutex);
       self->texture->state->destroyed = false;
-      self->texture->state->has_pending_frame = false;
-      self->texture->state->read_buf.clear();
-      self->texture->state->write_buf.clear();
+      self->texture->state->Reset();
+      self->texture->state->queue_depth = queue_depth;
+      self->texture->state->drop_newest = drop_newest;
+      self->texture->state->delivering = true;
       self->texture->state->needs_gl_reset = true; // Safe reset on next populate call
     }
 
@@ -334,6 +602,8 @@ static void handle_create_texture(FfmpegKitExtendedFlutterPlugin* self, FlMethod
   fl_texture_registrar_register_texture(self->texture_registrar, FL_TEXTURE(tex));
   self->texture = tex;
   self->texture->state->fl_texture_id = fl_texture_get_id(FL_TEXTURE(tex));
+  self->texture->state->queue_depth = queue_depth;
+  self->texture->state->drop_newest = drop_newest;
   
   ffplay_kit_register_frame_callback(on_frame_callback, tex);
   
@@ -357,6 +627,152 @@ static void handle_release_texture(FfmpegKitExtendedFlutterPlugin* self, FlMetho
   fl_method_call_respond_success(method_call, nullptr, nullptr);
 }
 
+static bool lookup_int_arg(FlValue* args, const char* key, int64_t* out) {
+  if (!args || fl_value_get_type(args) != FL_VALUE_TYPE_MAP) return false;
+  FlValue* val = fl_value_lookup_string(args, key);
+  if (!val || fl_value_get_type(val) != FL_VALUE_TYPE_INT) return false;
+  *out = fl_value_get_int(val);
+  return true;
+}
+
+static void handle_configure_frame_cache(FfmpegKitExtendedFlutterPlugin* self, FlMethodCall* method_call) {
+  FlValue* args = fl_method_call_get_args(method_call);
+  int64_t max_bytes = 0, downscale = 1;
+  if (!lookup_int_arg(args, "maxBytes", &max_bytes) || max_bytes < 0) {
+    fl_method_call_respond_error(method_call, "INVALID_ARGUMENT", "Expected maxBytes int >= 0", nullptr, nullptr);
+    return;
+  }
+  lookup_int_arg(args, "downscale", &downscale);
+  if (!self->texture) {
+    fl_method_call_respond_error(method_call, "NO_TEXTURE", "No texture has been created", nullptr, nullptr);
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(self->texture->state->mutex);
+    self->texture->state->frame_cache.Configure(static_cast<size_t>(max_bytes), static_cast<int>(downscale));
+  }
+  fl_method_call_respond_success(method_call, nullptr, nullptr);
+}
+
+static void handle_show_cached_frame(FfmpegKitExtendedFlutterPlugin* self, FlMethodCall* method_call) {
+  FlValue* args = fl_method_call_get_args(method_call);
+  int64_t position_ms = 0, tolerance_ms = 0;
+  if (!lookup_int_arg(args, "positionMs", &position_ms)) {
+    fl_method_call_respond_error(method_call, "INVALID_ARGUMENT", "Expected positionMs int", nullptr, nullptr);
+    return;
+  }
+  lookup_int_arg(args, "toleranceMs", &tolerance_ms);
+
+  g_autoptr(FlValue) result = fl_value_new_map();
+  bool hit = false;
+  if (self->texture) {
+    TextureState* state = self->texture->state;
+    std::lock_guard<std::mutex> lock(state->mutex);
+    const CachedFrame* frame = state->destroyed || !state->frame_cache.enabled()
+        ? nullptr
+        : state->frame_cache.Find(position_ms, tolerance_ms);
+    if (frame) {
+      // Replace anything queued so the cached frame is presented next.
+      while (!state->queue.empty()) {
+        state->Recycle(std::move(state->queue.front().pixels));
+        state->queue.pop_front();
+      }
+      QueuedFrame shown;
+      shown.pixels = frame->pixels;
+      shown.width = frame->width;
+      shown.height = frame->height;
+      shown.position_ms = frame->position_ms;
+      shown.decoded_us = g_get_monotonic_time();
+      state->queue.push_back(std::move(shown));
+      fl_value_set_string_take(result, "positionMs", fl_value_new_int(frame->position_ms));
+      hit = true;
+    }
+  }
+  if (hit) {
+    g_object_ref(self->texture);
+    g_idle_add(mark_frame_idle_cb, self->texture);
+  }
+  fl_value_set_string_take(result, "hit", fl_value_new_bool(hit));
+  fl_method_call_respond_success(method_call, result, nullptr);
+}
+
+static void handle_get_frame_cache_stats(FfmpegKitExtendedFlutterPlugin* self, FlMethodCall* method_call) {
+  g_autoptr(FlValue) result = fl_value_new_map();
+  if (self->texture) {
+    std::lock_guard<std::mutex> lock(self->texture->state->mutex);
+    const FrameCache& cache = self->texture->state->frame_cache;
+    fl_value_set_string_take(result, "maxBytes", fl_value_new_int(static_cast<int64_t>(cache.max_bytes)));
+    fl_value_set_string_take(result, "bytes", fl_value_new_int(static_cast<int64_t>(cache.bytes)));
+    fl_value_set_string_take(result, "entries", fl_value_new_int(static_cast<int64_t>(cache.lru.size())));
+    fl_value_set_string_take(result, "hits", fl_value_new_int(static_cast<int64_t>(cache.hits)));
+    fl_value_set_string_take(result, "misses", fl_value_new_int(static_cast<int64_t>(cache.misses)));
+    fl_value_set_string_take(result, "evictions", fl_value_new_int(static_cast<int64_t>(cache.evictions)));
+    if (!cache.index.empty()) {
+      fl_value_set_string_take(result, "firstMs", fl_value_new_int(cache.index.begin()->first));
+      fl_value_set_string_take(result, "lastMs", fl_value_new_int(cache.index.rbegin()->first));
+    }
+  }
+  fl_method_call_respond_success(method_call, result, nullptr);
+}
+
+static void handle_get_presentation_stats(FfmpegKitExtendedFlutterPlugin* self, FlMethodCall* method_call) {
+  g_autoptr(FlValue) result = fl_value_new_map();
+  if (self->texture) {
+    std::lock_guard<std::mutex> lock(self->texture->state->mutex);
+    const TextureState* state = self->texture->state;
+    const PresentationStats& stats = state->stats;
+    fl_value_set_string_take(result, "queueDepth", fl_value_new_int(static_cast<int64_t>(state->queue_depth)));
+    fl_value_set_string_take(result, "dropPolicy", fl_value_new_string(state->drop_newest ? "dropNewest" : "dropOldest"));
+    fl_value_set_string_take(result, "queued", fl_value_new_int(static_cast<int64_t>(state->queue.size())));
+    fl_value_set_string_take(result, "received", fl_value_new_int(static_cast<int64_t>(stats.received)));
+    fl_value_set_string_take(result, "presented", fl_value_new_int(static_cast<int64_t>(stats.presented)));
+    fl_value_set_string_take(result, "dropped", fl_value_new_int(static_cast<int64_t>(stats.dropped)));
+    fl_value_set_string_take(result, "janks", fl_value_new_int(static_cast<int64_t>(stats.janks)));
+    fl_value_set_string_take(result, "lastLatencyUs", fl_value_new_int(stats.last_latency_us));
+    fl_value_set_string_take(result, "maxLatencyUs", fl_value_new_int(stats.max_latency_us));
+    fl_value_set_string_take(result, "averageLatencyUs", fl_value_new_int(
+        stats.presented ? stats.total_latency_us / static_cast<int64_t>(stats.presented) : 0));
+    fl_value_set_string_take(result, "frameIntervalUs", fl_value_new_int(static_cast<int64_t>(stats.frame_interval_us)));
+    fl_value_set_string_take(result, "lastPositionMs", fl_value_new_int(stats.last_position_ms));
+  }
+  fl_method_call_respond_success(method_call, result, nullptr);
+}
+
+// Stops or restarts frame delivery for a hidden view.  While stopped the
+// decoder thread never calls into the plugin and no idle sources are queued;
+// the texture keeps showing the last presented frame.
+static void handle_set_frame_delivery(FfmpegKitExtendedFlutterPlugin* self, FlMethodCall* method_call) {
+  FlValue* args = fl_method_call_get_args(method_call);
+  FlValue* enabled_value = args && fl_value_get_type(args) == FL_VALUE_TYPE_MAP
+      ? fl_value_lookup_string(args, "enabled")
+      : nullptr;
+  if (!enabled_value || fl_value_get_type(enabled_value) != FL_VALUE_TYPE_BOOL) {
+    fl_method_call_respond_error(method_call, "INVALID_ARGUMENT", "Expected enabled boolean", nullptr, nullptr);
+    return;
+  }
+  bool enabled = fl_value_get_bool(enabled_value);
+  if (self->texture) {
+    TextureState* state = self->texture->state;
+    bool changed = false;
+    {
+      std::lock_guard<std::mutex> lock(state->mutex);
+      changed = !state->destroyed && state->delivering != enabled;
+      if (changed) state->delivering = enabled;
+    }
+    if (changed && enabled) {
+      ffplay_kit_register_frame_callback(on_frame_callback, self->texture);
+    } else if (changed) {
+      ffplay_kit_unregister_frame_callback();
+      std::lock_guard<std::mutex> lock(state->mutex);
+      while (!state->queue.empty()) {
+        state->Recycle(std::move(state->queue.front().pixels));
+        state->queue.pop_front();
+      }
+    }
+  }
+  fl_method_call_respond_success(method_call, nullptr, nullptr);
+}
+
 static void ffmpeg_kit_extended_flutter_plugin_handle_method_call(
     FfmpegKitExtendedFlutterPlugin* self, FlMethodCall* method_call) {
   const gchar* method = fl_method_call_get_name(method_call);
@@ -364,6 +780,16 @@ static void ffmpeg_kit_extended_flutter_plugin_handle_method_call(
     handle_create_texture(self, method_call);
   } else if (strcmp(method, "releaseTexture") == 0) {
     handle_release_texture(self, method_call);
+  } else if (strcmp(method, "configureFrameCache") == 0) {
+    handle_configure_frame_cache(self, method_call);
+  } else if (strcmp(method, "showCachedFrame") == 0) {
+    handle_show_cached_frame(self, method_call);
+  } else if (strcmp(method, "getFrameCacheStats") == 0) {
+    handle_get_frame_cache_stats(self, method_call);
+  } else if (strcmp(method, "getPresentationStats") == 0) {
+    handle_get_presentation_stats(self, method_call);
+  } else if (strcmp(method, "setFrameDelivery") == 0) {
+    handle_set_frame_delivery(self, method_call);
   } else {
     fl_method_call_respond_not_implemented(method_call, nullptr);
   }
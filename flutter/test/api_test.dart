@@ -20,6 +20,7 @@
 import 'dart:async';
 import 'dart:ffi';
 import 'dart:io';
+import 'dart:typed_data';
 
 import 'package:ffi/ffi.dart';
 import 'package:ffmpeg_kit_extended_flutter/ffmpeg_kit_extended_flutter.dart';
@@ -2672,6 +2673,42 @@ void main() {
         ffmpeg.ffmpeg_kit_free(strPtr.cast());
       });
     });
+
+    test('FFmpegKitTest PipeStreaming', () async {
+      // One second of 8 kHz mono s16le, delivered in small chunks.
+      const total = 16000;
+      final source = Stream.fromIterable([
+        for (var i = 0; i < total; i += 100) Uint8List(100),
+      ]);
+      final input = FFmpegPipeInput();
+      final output = FFmpegPipeOutput();
+      final received = output.stream.fold<int>(0, (n, c) => n + c.length);
+
+      final session = await FFmpegPipes.executeAsync(
+        FFmpegSession.fromArguments([
+          '-hide_banner',
+          '-loglevel',
+          'error',
+          '-f',
+          's16le',
+          '-ar',
+          '8000',
+          '-ac',
+          '1',
+          '-i',
+          input.path,
+          '-f',
+          's16le',
+          '-y',
+          output.path,
+        ]),
+        inputs: {input: source},
+        outputs: [output],
+      );
+
+      expect(ReturnCode.isSuccess(session.getReturnCode()), isTrue);
+      expect(await received, equals(total));
+    });
   });
 
   test('FFmpegKitTest RobustnessTest', () async {
@@ -3317,4 +3354,1192 @@ void main() {
       });
     });
   });
+
+  group('DartApiTests', () {
+    test('FFmpegKitTest MediaPipelineTest', () async {
+      final order = <String>[];
+      PipelineStage stage(
+        String id,
+        int delayMs, {
+        List<String> dependsOn = const [],
+        bool fail = false,
+      }) => PipelineStage(
+        id,
+        dependsOn: dependsOn,
+        run: (context) async {
+          for (final dep in dependsOn) {
+            expect(context.results.containsKey(dep), isTrue);
+          }
+          order.add(id);
+          await Future.delayed(Duration(milliseconds: delayMs));
+          if (fail) throw StateError('$id failed');
+          return PipelineStageResult(outputs: ['$id.out']);
+        },
+      );
+
+      final result = await MediaPipeline([
+        stage('probe', 10),
+        stage('transcode', 200, dependsOn: ['probe']),
+        stage('thumbnail', 20, dependsOn: ['probe']),
+        stage('waveform', 20, dependsOn: ['probe'], fail: true),
+        stage('upload', 10, dependsOn: ['waveform']),
+      ]).run();
+
+      expect(order.first, equals('probe'));
+      expect(result.stages['transcode']!.status, PipelineStageStatus.succeeded);
+      expect(result.stages['thumbnail']!.status, PipelineStageStatus.succeeded);
+      expect(result.stages['waveform']!.status, PipelineStageStatus.failed);
+      expect(result.stages['upload']!.status, PipelineStageStatus.cancelled);
+      expect(order, isNot(contains('upload')));
+      expect(result.succeeded, isFalse);
+      expect(result.criticalPath, equals(['probe', 'transcode']));
+      // Branches ran concurrently, so the run is shorter than their sum.
+      expect(result.elapsed.inMilliseconds, lessThan(10 + 200 + 20 + 20));
+      expect(result.resultOf('thumbnail')!.outputs, equals(['thumbnail.out']));
+
+      expect(
+        () => MediaPipeline([
+          stage('a', 0, dependsOn: ['b']),
+          stage('b', 0, dependsOn: ['a']),
+        ]),
+        throwsArgumentError,
+      );
+      expect(
+        () => MediaPipeline([stage('a', 0, dependsOn: ['missing'])]),
+        throwsArgumentError,
+      );
+      final duplicated = await MediaPipeline([
+        stage('a', 0),
+        stage('b', 0, dependsOn: ['a', 'a']),
+      ]).run();
+      expect(duplicated.succeeded, isTrue);
+    });
+
+    test('FFmpegKitTest AbrLadderArgumentsTest', () {
+      const renditions = [
+        Rendition(name: '720p', height: 720, videoBitrateKbps: 2800),
+        Rendition(name: '360p', height: 360, videoBitrateKbps: 800),
+      ];
+      final ladder = AbrLadder(
+        input: 'in.mp4',
+        outputDirectory: 'out',
+        renditions: renditions,
+      );
+      final args = ladder.buildArguments(statsPaths: ['s0.log', 's1.log']);
+
+      // A single input is decoded once and split into one branch per rung.
+      expect(args.where((a) => a == '-i').length, equals(1));
+      final graph = args[args.indexOf('-filter_complex') + 1];
+      expect(graph, startsWith('[0:v]split=2[s0][s1]'));
+      expect(graph, contains('[s1]scale=w=-2:h=360[v1]'));
+      expect(args, containsAllInOrder(['-b:v:1', '800k']));
+      expect(args, containsAllInOrder(['-stats_enc_post:v:0', 's0.log']));
+      expect(
+        args,
+        containsAllInOrder([
+          '-var_stream_map',
+          'v:0,a:0,name:720p v:1,a:1,name:360p',
+        ]),
+      );
+      expect(
+        ladder.outputs['360p'],
+        equals(path.join('out', '360p', 'index.m3u8')),
+      );
+
+      final mp4 = AbrLadder(
+        input: 'in.mp4',
+        outputDirectory: 'out',
+        renditions: renditions,
+        format: AbrFormat.mp4,
+        includeAudio: false,
+      ).buildArguments();
+      expect(mp4.where((a) => a.endsWith('.mp4')).length, equals(3));
+      expect(mp4, isNot(contains('0:a:0')));
+
+      expect(
+        () => AbrLadder(
+          input: 'in.mp4',
+          outputDirectory: 'out',
+          renditions: const [],
+        ),
+        throwsArgumentError,
+      );
+    });
+
+    test('FFmpegKitTest ProcessPoolParsingTest', () {
+      final stats = FFmpegProcessPool.parseProgress(
+        -1,
+        {
+          'frame': '120',
+          'fps': '59.94',
+          'stream_0_0_q': '28.0',
+          'bitrate': ' 512.3kbits/s',
+          'total_size': '262144',
+          'out_time_us': '4000000',
+          'dup_frames': '1',
+          'drop_frames': '2',
+          'speed': '1.98x',
+          'progress': 'continue',
+        },
+        2000,
+        8000,
+      );
+      expect(stats.sessionId, equals(-1));
+      expect(stats.time, equals(4000));
+      expect(stats.videoFrameNumber, equals(120));
+      expect(stats.videoQuality, closeTo(28.0, 1e-9));
+      expect(stats.bitrate, closeTo(512.3, 1e-9));
+      expect(stats.speed, closeTo(1.98, 1e-9));
+      expect(stats.size, equals(262144));
+      expect(stats.dropFrames, equals(2));
+      expect(stats.transcodingProgress, closeTo(0.5, 1e-9));
+
+      final warning = FFmpegProcessPool.parseLogLine(
+        -1,
+        '[h264 @ 0x1234] [warning] non-existing PPS',
+      );
+      expect(warning.logLevel, equals(LogLevel.warning));
+      expect(warning.message, equals('[h264 @ 0x1234] non-existing PPS\n'));
+      expect(
+        FFmpegProcessPool.parseLogLine(-1, 'plain').logLevel,
+        equals(LogLevel.info),
+      );
+    });
+
+    test('FFmpegKitTest ImageBatchWorkerArgumentsTest', () {
+      final worker = ImageBatchWorker(
+        filter: 'scale=64:-2',
+        outputOptions: ['-q:v', '4'],
+      );
+      final args = worker.buildArguments(
+        ['a.png', 'b.png'],
+        ['a.jpg', 'b.jpg'],
+      );
+      expect(args.where((a) => a == '-i').length, equals(2));
+      expect(
+        args[args.indexOf('-filter_complex') + 1],
+        equals('[0:v]scale=64:-2[o0];[1:v]scale=64:-2[o1]'),
+      );
+      expect(
+        args,
+        containsAllInOrder(['-map', '[o1]', '-frames:v', '1', '-q:v', 'b.jpg']),
+      );
+
+      final passthrough = ImageBatchWorker().buildArguments(['a.png'], [
+        'a.webp',
+      ]);
+      expect(passthrough, isNot(contains('-filter_complex')));
+      expect(passthrough, containsAllInOrder(['-map', '0:v:0']));
+      expect(() => ImageBatchWorker(batchSize: 0), throwsArgumentError);
+    });
+
+    test('FFmpegKitTest TranscodeCacheKeyTest', () async {
+      final input = File(path.join(tempDir.path, 'cache_input.bin'))
+        ..writeAsBytesSync([1, 2, 3]);
+      final cache = TranscodeCache(
+        directory: path.join(tempDir.path, 'transcode_cache'),
+      );
+      List<String> argv(String out, {String crf = '23'}) => [
+        '-i',
+        input.path,
+        '-crf',
+        crf,
+        out,
+      ];
+
+      final a = await cache.computeKey(argv('a.mp4'), 'a.mp4');
+      final b = await cache.computeKey(argv('b.mp4'), 'b.mp4');
+      final c = await cache.computeKey(argv('a.mp4', crf: '28'), 'a.mp4');
+      final d = await cache.computeKey(argv('a.mkv'), 'a.mkv');
+      expect(a, equals(b), reason: 'output path must not affect the key');
+      expect(a, isNot(equals(c)));
+      expect(a, isNot(equals(d)), reason: 'container is part of the key');
+
+      input.writeAsBytesSync([1, 2, 3, 4]);
+      expect(await cache.computeKey(argv('a.mp4'), 'a.mp4'), isNot(equals(a)));
+
+      final hashed = TranscodeCache(
+        directory: path.join(tempDir.path, 'transcode_cache'),
+        hashInputContent: true,
+      );
+      final copy = input.copySync(path.join(tempDir.path, 'cache_copy.bin'));
+      expect(
+        await hashed.computeKey(['-i', input.path, 'o.mp4'], 'o.mp4'),
+        equals(await hashed.computeKey(['-i', copy.path, 'o.mp4'], 'o.mp4')),
+      );
+    });
+
+    test('FFmpegKitTest MediaInformationCacheStoreTest', () async {
+      final media = File(path.join(tempDir.path, 'cached_media.bin'))
+        ..writeAsBytesSync([0, 1, 2]);
+      final storePath = path.join(tempDir.path, 'media_information.db');
+      final info = MediaInformation(
+        filename: media.path,
+        format: 'mov,mp4',
+        duration: '30.000000',
+        tagsJson: '{"title":"cached"}',
+        streams: [StreamInformation(index: 0, type: 'video', width: 512)],
+        chapters: [ChapterInformation(id: 1, start: 0, end: 1000)],
+      );
+
+      final writer = MediaInformationCache(storePath: storePath);
+      final key = await writer.keyFor(media.path);
+      expect(key, hasLength(64));
+      await writer.put(key!, info);
+      await writer.close();
+
+      // A new cache answers from the store without probing.
+      final reader = MediaInformationCache(storePath: storePath);
+      final cached = await reader.getMediaInformation(media.path);
+      expect(reader.hits, equals(1));
+      expect(reader.misses, equals(0));
+      expect(cached!.duration, equals('30.000000'));
+      expect(cached.tags!['title'], equals('cached'));
+      expect(cached.streams.single.width, equals(512));
+      expect(cached.chapters.single.end, equals(1000));
+
+      expect(await reader.keyFor('https://example.com/a.mp4'), isNull);
+
+      // Invalidation survives compaction; the file is left with no entries.
+      await reader.invalidate(media.path);
+      await reader.compact();
+      await reader.close();
+      expect(File(storePath).lengthSync(), equals(0));
+    });
+
+    test('FFmpegKitTest MediaInformationCacheCompactionTest', () async {
+      final storePath = path.join(tempDir.path, 'compacting.db');
+      final files = [
+        for (var i = 0; i < 32; i++)
+          File(path.join(tempDir.path, 'compacting_$i.bin'))
+            ..writeAsBytesSync([i]),
+      ];
+
+      final writer = MediaInformationCache(storePath: storePath);
+      for (final file in files) {
+        final key = await writer.keyFor(file.path);
+        await writer.put(key!, MediaInformation(filename: file.path));
+        // Stale versions give the compaction something to move.
+        await writer.put(key, MediaInformation(filename: file.path));
+      }
+      await writer.close();
+
+      // Nothing is held in memory, so every lookup reads the store while the
+      // compaction relocates its entries.
+      final reader = MediaInformationCache(
+        storePath: storePath,
+        maxMemoryEntries: 0,
+      );
+      final compaction = reader.compact();
+      final lookups = Future.wait([
+        for (final file in files) reader.getMediaInformation(file.path),
+      ]);
+      await compaction;
+      final results = await lookups;
+
+      expect(reader.misses, equals(0));
+      expect(reader.hits, equals(files.length));
+      for (var i = 0; i < files.length; i++) {
+        expect(results[i]!.filename, equals(files[i].path));
+      }
+      await reader.close();
+    });
+
+    test('FFmpegKitTest FastProbeParsingTest', () {
+      final args = FastProbe.buildArguments(
+        'in.mp4',
+        fields: {ProbeField.duration, ProbeField.dimensions},
+        probeSize: 32768,
+        analyzeDuration: const Duration(milliseconds: 250),
+      );
+      expect(args, containsAllInOrder(['-probesize', '32768']));
+      expect(args, containsAllInOrder(['-analyzeduration', '250000']));
+      expect(
+        args[args.indexOf('-show_entries') + 1],
+        equals('format=duration:stream=index,codec_type,width,height'),
+      );
+      expect(args.last, equals('in.mp4'));
+
+      final result = FastProbe.parseOutput(
+        'in.mp4',
+        'stream|index=0|codec_name=h264|codec_type=video|width=512|height=512'
+        '|tag:title=a\\|b\n'
+        'stream|index=1|codec_name=aac|codec_type=audio|tag:language=eng'
+        '|tag:comment=x\\r\\ny\\\\\n'
+        'format|duration=30.000000|format_name=mov,mp4|bit_rate=1200\n',
+      );
+      expect(result.duration, closeTo(30.0, 1e-9));
+      expect(result.formatName, equals('mov,mp4'));
+      expect(result.bitrate, equals(1200));
+      expect(result.streams, hasLength(2));
+      expect(result.videoStream!.width, equals(512));
+      expect(result.videoStream!.tags['title'], equals('a|b'));
+      expect(result.streams[1].tags['language'], equals('eng'));
+      expect(result.streams[1].tags['comment'], equals('x\r\ny\\'));
+    });
+
+    test('FFmpegKitTest MediaProbePoolTest', () {
+      final pool = MediaProbePool(concurrency: 2, probeSize: 65536);
+      final args = pool.buildArguments('in.mkv');
+      expect(args, containsAllInOrder(['-probesize', '65536']));
+      expect(args, containsAllInOrder(['-print_format', 'json']));
+      expect(args.sublist(args.length - 2), equals(['-i', 'in.mkv']));
+      expect(
+        MediaProbePool.defaultConcurrency(['http://a/1.mp4', 'http://a/2.mp4']),
+        equals(16),
+      );
+      expect(
+        MediaProbePool.defaultConcurrency(['/a.mp4', '/b.mp4']),
+        inInclusiveRange(2, 8),
+      );
+      expect(() => MediaProbePool(concurrency: 0), throwsArgumentError);
+
+      final info = MediaInformation.fromFFprobeJson({
+        'streams': [
+          {
+            'index': 0,
+            'codec_name': 'h264',
+            'codec_type': 'video',
+            'width': 512,
+            'height': 512,
+            'pix_fmt': 'yuv420p',
+            'avg_frame_rate': '30/1',
+            'tags': {'language': 'und'},
+          },
+        ],
+        'chapters': [
+          {'id': 1, 'start': 0, 'end': 1000, 'tags': {'title': 'Intro'}},
+        ],
+        'format': {
+          'filename': 'in.mkv',
+          'format_name': 'matroska,webm',
+          'duration': '30.000000',
+          'bit_rate': '1200',
+          'tags': {'title': 'Test'},
+        },
+      });
+      expect(info.filename, equals('in.mkv'));
+      expect(info.format, equals('matroska,webm'));
+      expect(info.tags!['title'], equals('Test'));
+      expect(info.allProperties!['bit_rate'], equals('1200'));
+      expect(info.streams.single.format, equals('yuv420p'));
+      expect(info.streams.single.averageFrameRate, equals('30/1'));
+      expect(info.streams.single.tags!['language'], equals('und'));
+      expect(info.chapters.single.tags!['title'], equals('Intro'));
+      // Only the encoded JSON is retained; decoded maps are read-only.
+      expect(info.tagsJson, equals('{"title":"Test"}'));
+      expect(() => info.tags!['title'] = 'Changed', throwsUnsupportedError);
+      expect(
+        MediaInformation.fromJson(info.toJson()).tags!['title'],
+        equals('Test'),
+      );
+    });
+
+    test('FFmpegKitTest MediaProbePoolIntegrationTest', () async {
+      if (!File(getTestVideoFile()).existsSync()) {
+        generateTestVideoFile();
+      }
+      final video = getTestVideoFile();
+      final missing = path.join(tempDir.path, 'missing.mp4');
+
+      // Failures arrive as stream errors without stopping the other probes.
+      final results = <MediaInformation>[];
+      final errors = <Object>[];
+      await FFprobeKit.probeAll([video, missing])
+          .handleError(errors.add)
+          .forEach(results.add);
+      expect(results, hasLength(1));
+      expect(results.single.streams.single.width, equals(512));
+      expect(errors, hasLength(1));
+      expect(errors.single, isA<ProbeException>());
+      expect((errors.single as ProbeException).path, equals(missing));
+
+      // Same batch through the pool and through sequential sessions.
+      const count = 8;
+      final pool = MediaProbePool(concurrency: 4);
+      expect((await pool.probe(video)).duration, startsWith('30.'));
+      final pooled = Stopwatch()..start();
+      final batch = await pool.probeAll(List.filled(count, video)).toList();
+      pooled.stop();
+      await pool.close();
+      expect(batch, hasLength(count));
+
+      final sequential = Stopwatch()..start();
+      for (var i = 0; i < count; i++) {
+        final session = await FFprobeKit.getMediaInformationAsync(video);
+        expect(
+          (session as MediaInformationSession).getMediaInformation(),
+          isNotNull,
+        );
+      }
+      sequential.stop();
+      if (kDebugMode) {
+        print(
+          'Probed $count inputs: pool ${pooled.elapsedMilliseconds} ms, '
+          'sequential ${sequential.elapsedMilliseconds} ms',
+        );
+      }
+    });
+
+    test('FFmpegKitTest MediaInformationLazyDecodeTest', () {
+      final stream = StreamInformation(
+        index: 0,
+        tagsJson: '{"language":"eng"}',
+        allPropertiesJson: 'not json',
+      );
+      expect(stream.tags!['language'], equals('eng'));
+      expect(identical(stream.tags, stream.tags), isTrue);
+      expect(stream.allProperties, isNull);
+
+      final info = MediaInformation.fromJson(
+        MediaInformation(
+          filename: 'a.mp4',
+          tagsJson: '{"title":"A"}',
+          streams: [stream],
+        ).toJson(),
+      );
+      expect(info.tags!['title'], equals('A'));
+      expect(identical(info.tags, info.tags), isTrue);
+      expect(info.streams.single.tags!['language'], equals('eng'));
+      expect(ChapterInformation(tagsJson: '').tags, isNull);
+    });
+
+    test('FFmpegKitTest KeyframeIndexTest', () {
+      final index = KeyframeIndex.parseOutput(
+        'in.ts',
+        [
+          '0.000000,0.000000,564,K__',
+          '0.040000,0.040000,1128,___',
+          '0.080000,0.080000,1692,___',
+          'N/A,2.000000,9400,K__',
+          '2.040000,2.040000,9964,___',
+          '4.000000,4.000000,18800,K_',
+          '6.500000,6.500000,N/A,K__',
+          '6.540000,6.540000,30080,___',
+          '',
+        ].join('\n'),
+      );
+      expect(index.times, equals([0.0, 2.0, 4.0, 6.5]));
+      expect(index.positions, equals([564, 9400, 18800, -1]));
+      expect(index.gopSizes, equals([3, 2, 1, 2]));
+      expect(index.endTime, equals(6.54));
+
+      expect(index.keyframeBefore(3.9), equals(2.0));
+      expect(index.keyframeBefore(4.0), equals(4.0));
+      expect(index.keyframeBefore(-1), equals(0.0));
+      expect(index.keyframeAfter(2.1), equals(4.0));
+      expect(index.keyframeAfter(7), isNull);
+      expect(
+        index.splitPoints(const Duration(seconds: 3)),
+        equals([0.0, 4.0]),
+      );
+
+      final restored = KeyframeIndex.fromBytes('in.ts', index.toBytes());
+      expect(restored.times, equals(index.times));
+      expect(restored.positions, equals(index.positions));
+      expect(restored.gopSizes, equals(index.gopSizes));
+      expect(restored.endTime, equals(index.endTime));
+      expect(
+        () => KeyframeIndex.fromBytes('in.ts', Uint8List(4)),
+        throwsFormatException,
+      );
+
+      expect(
+        KeyframeIndex.buildArguments('in.ts'),
+        containsAllInOrder(['-select_streams', 'v:0', '-of', 'csv=p=0']),
+      );
+    });
+
+    test('FFmpegKitTest MemoryFileTest', () {
+      if (!FFmpegMemoryFile.isSupported) return;
+      final bytes = Uint8List.fromList(List.generate(3 << 20, (i) => i & 0xff));
+      final file = FFmpegMemoryFile.fromBytes(bytes);
+      expect(file.length, equals(bytes.length));
+      expect(file.readAsBytes(), equals(bytes));
+      expect(
+        file.inputArguments,
+        equals(['-fd', '${file.fd}', '-i', 'fd:']),
+      );
+      expect(
+        file.outputArguments('mp4'),
+        equals(['-fd', '${file.fd}', '-f', 'mp4', 'fd:']),
+      );
+
+      file.clear();
+      expect(file.length, equals(0));
+      file.close();
+      expect(() => file.readAsBytes(), throwsStateError);
+    });
+
+    test('FFmpegKitTest MemoryFileTranscodeTest', () async {
+      if (!FFmpegMemoryFile.isSupported) return;
+
+      // Generate a short clip straight into memory, then transcode it from
+      // one in-memory file to another.
+      final generated = FFmpegMemoryFile.create();
+      final generate = await FFmpegSession.fromArguments([
+        '-hide_banner',
+        '-loglevel',
+        'error',
+        '-f',
+        'lavfi',
+        '-i',
+        'testsrc=duration=1:size=64x64:rate=10',
+        '-c:v',
+        'mpeg4',
+        ...generated.outputArguments('matroska'),
+      ]).executeAsync();
+      expect(ReturnCode.isSuccess(generate.getReturnCode()), isTrue);
+      final clip = generated.readAsBytes();
+      generated.close();
+      expect(clip, isNotEmpty);
+
+      final (:session, :output) = await FFmpegMemoryFile.transcode(
+        clip,
+        format: 'mp4',
+        outputOptions: ['-c:v', 'mpeg4'],
+      );
+      expect(ReturnCode.isSuccess(session.getReturnCode()), isTrue);
+      expect(output, isNotNull);
+      expect(String.fromCharCodes(output!.sublist(4, 8)), equals('ftyp'));
+      // The mp4 muxer seeks back to patch the header, so a complete index
+      // proves the output was seekable.
+      expect(String.fromCharCodes(output).contains('moov'), isTrue);
+
+      await expectLater(
+        FFmpegMemoryFile.transcode(
+          clip,
+          format: 'mp4',
+          outputOptions: ['-movflags', '+faststart'],
+        ),
+        throwsArgumentError,
+      );
+    });
+
+    test('FFmpegKitTest LiveOutputTest', () async {
+      Uint8List box(String type, int bodyLength) {
+        final bytes = Uint8List(8 + bodyLength);
+        ByteData.sublistView(bytes).setUint32(0, 8 + bodyLength);
+        bytes.setRange(4, 8, type.codeUnits);
+        return bytes;
+      }
+
+      final stream = <int>[
+        ...box('ftyp', 16),
+        ...box('moov', 40),
+        ...box('moof', 24),
+        ...box('mdat', 100),
+        ...box('styp', 4),
+        ...box('moof', 24),
+        ...box('mdat', 0),
+      ];
+      // Deliver in awkward pieces so box headers straddle chunk boundaries.
+      final pieces = <List<int>>[
+        for (var i = 0; i < stream.length; i += 7)
+          stream.sublist(i, i + 7 > stream.length ? stream.length : i + 7),
+      ];
+      final chunks = await FragmentedMp4Output.splitFragments(
+        Stream.fromIterable(pieces),
+      ).toList();
+      expect(
+        chunks.map((c) => c.kind),
+        equals([
+          OutputChunkKind.init,
+          OutputChunkKind.fragment,
+          OutputChunkKind.fragment,
+        ]),
+      );
+      expect(chunks.map((c) => c.length), equals([72, 140, 52]));
+      expect(chunks.map((c) => c.offset), equals([0, 72, 212]));
+      expect(chunks.expand((c) => c.bytes!), equals(stream));
+
+      final entry = SegmentListOutput.parseListEntry(
+        'segment_00003.ts,12.000000,16.016000',
+      );
+      expect(entry!.$1, equals('segment_00003.ts'));
+      expect(entry.$2, equals(const Duration(seconds: 12)));
+      expect(entry.$3, equals(const Duration(microseconds: 16016000)));
+      expect(SegmentListOutput.parseListEntry('garbage'), isNull);
+    });
+
+    test('FFmpegKitTest WriteBehindOutputTest', () async {
+      final data = Uint8List.fromList(List.generate(50000, (i) => i % 251));
+      final destination = path.join(tempDir.path, 'write_behind.bin');
+      final written = await WriteBehindOutput.writeStream(
+        Stream.fromIterable([
+          for (var i = 0; i < data.length; i += 3000)
+            data.sublist(i, i + 3000 > data.length ? data.length : i + 3000),
+        ]),
+        destination,
+        blockSize: 4096,
+        maxQueuedBlocks: 1,
+        syncInterval: 8192,
+      );
+      expect(written, equals(data.length));
+      expect(await File(destination).readAsBytes(), equals(data));
+
+      await expectLater(
+        WriteBehindOutput.writeStream(
+          Stream<List<int>>.error(StateError('source failed')),
+          destination,
+        ),
+        throwsStateError,
+      );
+    });
+
+    test('FFmpegKitTest ReadAheadInputTest', () async {
+      Uint8List box(String type, int bodyLength) {
+        final bytes = Uint8List(8 + bodyLength);
+        ByteData.sublistView(bytes).setUint32(0, 8 + bodyLength);
+        bytes.setRange(4, 8, type.codeUnits);
+        return bytes;
+      }
+
+      final faststart = File(path.join(tempDir.path, 'faststart.mp4'))
+        ..writeAsBytesSync([
+          ...box('ftyp', 8),
+          ...box('moov', 16),
+          ...box('mdat', 64),
+        ]);
+      final trailing = File(path.join(tempDir.path, 'trailing.mp4'))
+        ..writeAsBytesSync([
+          ...box('ftyp', 8),
+          ...box('mdat', 64),
+          ...box('moov', 16),
+        ]);
+      final ts = File(path.join(tempDir.path, 'capture.ts'))
+        ..writeAsBytesSync(
+          List.generate(1 << 20, (i) => i % 188 == 0 ? 0x47 : i & 0xff),
+        );
+      expect(await ReadAheadInput.isSequential(faststart.path), isTrue);
+      expect(await ReadAheadInput.isSequential(trailing.path), isFalse);
+      expect(await ReadAheadInput.isSequential(ts.path), isTrue);
+
+      final input = await ReadAheadInput.open(
+        ts.path,
+        blockSize: 64 * 1024,
+        windowBlocks: 4,
+        expectSeeks: true,
+      );
+      expect(input.isEnabled, isFalse);
+      expect(input.inputArguments, equals(['-i', ts.path]));
+      expect(input.pipeInputs, isEmpty);
+
+      final read = await input.blocks().expand((b) => b).toList();
+      expect(read, equals(ts.readAsBytesSync()));
+      final stats = input.statistics;
+      expect(stats.bytesRead, equals(1 << 20));
+      expect(stats.hits + stats.misses, equals(16));
+    });
+
+    test('FFmpegKitTest PlaybackClockTest', () {
+      var now = Duration.zero;
+      final clock = PlaybackClock(elapsed: () => now)..duration = 10.0;
+
+      clock.reset(1.0, running: true);
+      now += const Duration(milliseconds: 500);
+      expect(clock.position, closeTo(1.5, 1e-9));
+
+      // A native reading behind the interpolated value is held, not rewound.
+      clock.sync(1.2, true);
+      expect(clock.position, closeTo(1.5, 1e-9));
+      now += const Duration(milliseconds: 500);
+      expect(clock.position, closeTo(1.7, 1e-9));
+
+      clock.pause(1.8);
+      now += const Duration(seconds: 5);
+      expect(clock.isRunning, isFalse);
+      expect(clock.position, closeTo(1.8, 1e-9));
+
+      // Seeking backwards is accepted, and so is the next native value.
+      clock.seek(0.5);
+      expect(clock.isSeekPending, isTrue);
+      expect(clock.position, closeTo(0.5, 1e-9));
+      clock.sync(double.nan, false);
+      expect(clock.isSeekPending, isTrue);
+      clock.sync(0.4, true);
+      expect(clock.isSeekPending, isFalse);
+      expect(clock.position, closeTo(0.4, 1e-9));
+
+      clock.rate = 2.0;
+      now += const Duration(seconds: 1);
+      expect(clock.position, closeTo(2.4, 1e-9));
+
+      // Interpolation is capped at the duration, and playback ending freezes
+      // the clock there even if the native layer has reset to zero.
+      now += const Duration(seconds: 10);
+      expect(clock.position, closeTo(10.0, 1e-9));
+      clock.sync(0.0, false);
+      now += const Duration(seconds: 1);
+      expect(clock.position, closeTo(10.0, 1e-9));
+    });
+
+    test('FFmpegKitTest FFplayEventTrackerTest', () {
+      final tracker = FFplayEventTracker(stallSamples: 2);
+
+      var events = tracker.update(const FFplayStatus(position: 0.0));
+      expect(events.single, isA<FFplayStateChanged>());
+      expect(tracker.state, equals(FFplayPlaybackState.stopped));
+
+      events = tracker.update(
+        const FFplayStatus(
+          width: 640,
+          height: 360,
+          playing: true,
+          position: 0.1,
+        ),
+      );
+      expect(events, hasLength(2));
+      expect((events[0] as FFplayVideoSizeChanged).width, equals(640));
+      expect(
+        (events[1] as FFplayStateChanged).state,
+        equals(FFplayPlaybackState.playing),
+      );
+
+      // Unchanged samples are silent until the position stalls.
+      const stalled = FFplayStatus(
+        width: 640,
+        height: 360,
+        playing: true,
+        position: 0.5,
+      );
+      expect(tracker.update(stalled), isEmpty);
+      expect(tracker.update(stalled), isEmpty);
+      events = tracker.update(stalled);
+      expect((events.single as FFplayBufferingChanged).buffering, isTrue);
+      events = tracker.update(
+        const FFplayStatus(
+          width: 640,
+          height: 360,
+          playing: true,
+          position: 0.7,
+        ),
+      );
+      expect((events.single as FFplayBufferingChanged).buffering, isFalse);
+
+      // A seek completes on the first valid position, even a backwards one.
+      tracker.seekIssued(0.2);
+      expect(
+        tracker.update(
+          const FFplayStatus(width: 640, height: 360, playing: true),
+        ),
+        isEmpty,
+      );
+      events = tracker.update(
+        const FFplayStatus(
+          width: 640,
+          height: 360,
+          playing: true,
+          position: 0.2,
+        ),
+      );
+      expect((events.single as FFplaySeekComplete).position, equals(0.2));
+
+      events = tracker.update(
+        const FFplayStatus(width: 640, height: 360, position: 9.9),
+      );
+      expect(events, hasLength(2));
+      expect(
+        (events[0] as FFplayStateChanged).state,
+        equals(FFplayPlaybackState.stopped),
+      );
+      expect((events[1] as FFplayEndOfFile).position, equals(0.2));
+    });
+
+    test('FFmpegKitTest FFplayPrepareInputTest', () {
+      expect(
+        FFplayPreparePool.inputOf('-autoexit -i "/media/a b.mp4" -x 640'),
+        equals('/media/a b.mp4'),
+      );
+      expect(
+        FFplayPreparePool.inputOf('-autoexit /media/clip.mkv'),
+        equals('/media/clip.mkv'),
+      );
+      expect(FFplayPreparePool.inputOf('-nodisp -autoexit'), isNull);
+      expect(() => FFplayPreparePool(capacity: 0), throwsArgumentError);
+    });
+
+    test('FFmpegKitTest FFplayPlaylistTest', () {
+      final starts = FFplayPlaylist.offsetsOf([10.0, 2.5, 7.5]);
+      expect(starts, equals([0.0, 10.0, 12.5]));
+      expect(FFplayPlaylist.indexAt(starts, 0.0), equals(0));
+      expect(FFplayPlaylist.indexAt(starts, 9.99), equals(0));
+      expect(FFplayPlaylist.indexAt(starts, 10.0), equals(1));
+      expect(FFplayPlaylist.indexAt(starts, 12.6), equals(2));
+      expect(FFplayPlaylist.indexAt(starts, 99.0), equals(2));
+
+      final list = FFplayPlaylist.buildConcatList(
+        ['/media/a.mp4', "/media/it's.mp4", 'https://example.com/c.mp4'],
+        [10.0, 2.5, 7.5],
+      );
+      expect(
+        list.split('\n'),
+        equals([
+          'ffconcat version 1.0',
+          "file '/media/a.mp4'",
+          'duration 10.0',
+          "file '/media/it'\\''s.mp4'",
+          'duration 2.5',
+          "file 'https://example.com/c.mp4'",
+          'duration 7.5',
+          '',
+        ]),
+      );
+    });
+
+    test('FFmpegKitTest FrameCacheStatisticsTest', () {
+      final stats = FrameCacheStatistics.fromMap({
+        'maxBytes': 1024,
+        'bytes': 512,
+        'entries': 2,
+        'hits': 3,
+        'misses': 1,
+        'evictions': 4,
+        'firstMs': 1500,
+        'lastMs': 1540,
+      });
+      expect(stats.entries, equals(2));
+      expect(stats.hitRatio, equals(0.75));
+      expect(stats.first, equals(const Duration(milliseconds: 1500)));
+      expect(stats.last, equals(const Duration(milliseconds: 1540)));
+
+      final empty = FrameCacheStatistics.fromMap({});
+      expect(empty.maxBytes, equals(0));
+      expect(empty.hitRatio, equals(0.0));
+      expect(empty.first, isNull);
+    });
+
+    test('FFmpegKitTest FFplaySeekSchedulerTest', () async {
+      final keyframes = KeyframeIndex(
+        'a.mp4',
+        Float64List.fromList([0, 2, 4, 6]),
+        Int64List(4),
+        Int32List(4),
+        endTime: 8,
+      );
+      final issued = <double>[];
+      final scheduler = FFplaySeekScheduler(
+        issued.add,
+        minInterval: const Duration(milliseconds: 40),
+        refineDelay: const Duration(milliseconds: 60),
+        keyframeIndex: keyframes,
+        seeksExactly: true,
+      );
+      expect(scheduler.snap(2.9), equals(2.0));
+      expect(scheduler.snap(5.1), equals(6.0));
+
+      expect(
+        await scheduler.request(2.9, FFplaySeekMode.keyframe),
+        equals(2.0),
+      );
+
+      // A burst inside one interval collapses to its last request, which is
+      // issued snapped and then refined once the burst is over.
+      final r2 = scheduler.request(3.2, FFplaySeekMode.accurate);
+      final r3 = scheduler.request(3.4, FFplaySeekMode.accurate);
+      final r4 = scheduler.request(5.1, FFplaySeekMode.fastThenRefine);
+      expect(await r2, isNull);
+      expect(await r3, isNull);
+      expect(await r4, equals(5.1));
+      expect(issued, equals([2.0, 6.0, 5.1]));
+
+      // A new request cancels a refinement that has not run yet.
+      final r5 = scheduler.request(0.9, FFplaySeekMode.fastThenRefine);
+      await Future<void>.delayed(const Duration(milliseconds: 50));
+      final r6 = scheduler.request(4.0, FFplaySeekMode.accurate);
+      expect(await r5, isNull);
+      expect(await r6, equals(4.0));
+      await Future<void>.delayed(const Duration(milliseconds: 100));
+      expect(issued, equals([2.0, 6.0, 5.1, 0.0, 4.0]));
+      expect(scheduler.issuedCount, equals(5));
+      expect(scheduler.supersededCount, equals(3));
+
+      // FFplay resumes from the keyframe before the target, so refining a
+      // forward snap would jump back; the refine step is skipped.
+      final ffplayIssued = <double>[];
+      final ffplay = FFplaySeekScheduler(
+        ffplayIssued.add,
+        refineDelay: const Duration(milliseconds: 10),
+        keyframeIndex: keyframes,
+      );
+      expect(ffplay.landing(5.1), equals(4.0));
+      expect(
+        await ffplay.request(5.1, FFplaySeekMode.fastThenRefine),
+        equals(6.0),
+      );
+      await Future<void>.delayed(const Duration(milliseconds: 30));
+      expect(ffplayIssued, equals([6.0]));
+    });
+
+    test('FFmpegKitTest FramePresentationStatisticsTest', () {
+      final stats = FramePresentationStatistics.fromMap({
+        'queueDepth': 3,
+        'dropPolicy': 'dropNewest',
+        'queued': 1,
+        'received': 100,
+        'presented': 95,
+        'dropped': 4,
+        'janks': 2,
+        'lastLatencyUs': 9000,
+        'averageLatencyUs': 12000,
+        'maxLatencyUs': 40000,
+        'frameIntervalUs': 41708,
+        'lastPositionMs': 4170,
+      });
+      expect(stats.queueDepth, 3);
+      expect(stats.policy, FramePresentationPolicy.everyFrame);
+      expect(stats.presented, 95);
+      expect(stats.dropped, 4);
+      expect(stats.janks, 2);
+      expect(stats.averageLatency, const Duration(milliseconds: 12));
+      expect(stats.maxLatency, const Duration(milliseconds: 40));
+      expect(stats.frameInterval, const Duration(microseconds: 41708));
+      expect(stats.lastPosition, const Duration(milliseconds: 4170));
+      expect(stats.dropRatio, closeTo(0.04, 1e-9));
+
+      final empty = FramePresentationStatistics.fromMap({
+        'lastPositionMs': -1,
+      });
+      expect(empty.policy, FramePresentationPolicy.latest);
+      expect(empty.queueDepth, 1);
+      expect(empty.lastPosition, isNull);
+      expect(empty.dropRatio, 0.0);
+
+      expect(FramePresentationPolicy.latest.wireName, 'dropOldest');
+      expect(FramePresentationPolicy.everyFrame.wireName, 'dropNewest');
+    });
+
+    test('FFmpegKitTest FFplayAudioTapTest', () async {
+      final ring = PcmRingBuffer(4, 2);
+      ring.write(Float32List.fromList([1, 2, 3, 4, 5, 6]));
+      expect(ring.length, 3);
+      expect(ring.latest(2), [3, 4, 5, 6]);
+      ring.write(Float32List.fromList([7, 8, 9, 10, 11, 12]));
+      expect(ring.length, 4);
+      expect(ring.totalFrames, 6);
+      expect(ring.latest(10), [5, 6, 7, 8, 9, 10, 11, 12]);
+      ring.write(Float32List.fromList(List.generate(20, (i) => i + 100.0)));
+      expect(ring.latest(4), [112, 113, 114, 115, 116, 117, 118, 119]);
+      ring.clear();
+      expect(ring.latest(4), isEmpty);
+
+      // Seven mono frames in 5-byte chunks, blocks of 3, every 2nd frame.
+      final bytes = Float32List.fromList(
+        [0, 1, 2, 3, 4, 5, 6],
+      ).buffer.asUint8List();
+      final blocks = await FFplayAudioTap.decodeBlocks(
+        Stream.fromIterable([
+          for (var i = 0; i < bytes.length; i += 5)
+            bytes.sublist(i, i + 5 > bytes.length ? bytes.length : i + 5),
+        ]),
+        channels: 1,
+        sampleRate: 4,
+        blockFrames: 3,
+        decimation: 2,
+        startPts: 10.0,
+      ).toList();
+      expect(blocks.map((b) => b.samples.toList()), [
+        [0, 2],
+        [4],
+        [6],
+      ]);
+      expect(blocks.map((b) => b.pts), [10.0, 11.0, 11.5]);
+      expect(blocks.first.sampleRate, 2);
+      expect(blocks.first.endPts, 11.0);
+
+      final tap = FFplayAudioTap('/media/a.mp4', decimation: 4);
+      expect(tap.outputSampleRate, 12000);
+      expect(tap.ring.capacityFrames, 24000);
+      expect(tap.buildArguments(1.5, 'pipe:x'), [
+        '-hide_banner',
+        '-re',
+        '-ss',
+        '1.500',
+        '-i',
+        '/media/a.mp4',
+        '-vn',
+        '-ac',
+        '2',
+        '-ar',
+        '48000',
+        '-f',
+        'f32le',
+        'pipe:x',
+      ]);
+      expect(FFplayAudioTap.supportsInput('/media/a.mp4'), isTrue);
+      expect(FFplayAudioTap.supportsInput('https://a/b.m3u8'), isTrue);
+      expect(FFplayAudioTap.supportsInput('udp://127.0.0.1:5000'), isFalse);
+      expect(FFplayAudioTap.supportsInput('pipe:0'), isFalse);
+      // Seeks within restartDelay coalesce; close cancels the pending one.
+      tap.seekTo(3.0);
+      tap.seekTo(4.0);
+      expect(tap.isRunning, isFalse);
+      await tap.close();
+    });
+
+    test('FFplayKitInteractiveTest IdleWakeups', () async {
+      if (!File(getTestVideoFile()).existsSync()) {
+        generateTestVideoFile();
+      }
+      final session = await FFplayKit.createSession(
+        '-loglevel fatal -i ${getTestVideoFile()}',
+      );
+      final states = <FFplayPlaybackState>[];
+      final eventSub = session.events.listen((event) {
+        if (event is FFplayStateChanged) states.add(event.state);
+      });
+      final positionSub = session.positionStream.listen((_) {});
+      final done = session.executeAsync();
+
+      await Future.delayed(const Duration(seconds: 1));
+      expect(session.isIdle, isFalse);
+      expect(session.wakeupCount, greaterThan(0));
+
+      // Paused: the pause is reported, then no timer fires at all.
+      session.pause();
+      await Future.delayed(const Duration(seconds: 1));
+      expect(states.last, FFplayPlaybackState.paused);
+      expect(session.isIdle, isTrue);
+      final pausedWakeups = session.wakeupCount;
+      await Future.delayed(const Duration(seconds: 1));
+      expect(session.wakeupCount, pausedWakeups);
+
+      // Resumed: polling restarts and the change is reported.
+      session.resume();
+      await Future.delayed(const Duration(seconds: 1));
+      expect(session.isIdle, isFalse);
+      expect(session.wakeupCount, greaterThan(pausedWakeups));
+      expect(states.last, FFplayPlaybackState.playing);
+
+      // Hidden while playing: idle at once, awake again when shown.
+      session.setVisible(false);
+      expect(session.isIdle, isTrue);
+      final hiddenWakeups = session.wakeupCount;
+      await Future.delayed(const Duration(seconds: 1));
+      expect(session.wakeupCount, hiddenWakeups);
+      session.setVisible(true);
+      await Future.delayed(const Duration(milliseconds: 500));
+      expect(session.wakeupCount, greaterThan(hiddenWakeups));
+
+      await eventSub.cancel();
+      await positionSub.cancel();
+      session.cancel();
+      await done.timeout(const Duration(seconds: 10));
+    });
+
+    test('FFmpegKitTest FFplayLiveTest', () {
+      expect(const FFplayLowLatencyProfile().arguments, [
+        '-fflags',
+        'nobuffer',
+        '-flags',
+        'low_delay',
+        '-probesize',
+        '32',
+        '-analyzeduration',
+        '0',
+        '-framedrop',
+        '-sync',
+        'ext',
+      ]);
+      expect(
+        const FFplayLowLatencyProfile(
+          probeSize: 8,
+          dropLateFrames: false,
+          externalClock: false,
+        ).options,
+        '-fflags nobuffer -flags low_delay -probesize 32 -analyzeduration 0',
+      );
+
+      final noon = DateTime.utc(2026, 3, 1, 12);
+      expect(FFplayLiveReference.timeOfDayOffset(noon), 43200.0);
+      const tod = FFplayLiveReference.timeOfDay();
+      expect(
+        tod.captureTimeOf(43199.5, noon),
+        DateTime.utc(2026, 3, 1, 11, 59, 59, 500),
+      );
+      // Just after midnight, content stamped just before it is from yesterday.
+      final early = DateTime.utc(2026, 3, 1, 0, 0, 1);
+      expect(
+        tod.captureTimeOf(86399.0, early),
+        DateTime.utc(2026, 2, 28, 23, 59, 59),
+      );
+
+      var position = 0.0;
+      var now = noon;
+      final monitor = FFplayLatencyMonitor(
+        () => position,
+        FFplayLiveReference.anchored(0.0, noon),
+        target: const Duration(milliseconds: 300),
+        now: () => now,
+      );
+      expect(monitor.sample(), isNull); // nothing displayed yet
+      position = 1.0;
+      now = noon.add(const Duration(milliseconds: 1200));
+      expect(monitor.sample(), const Duration(milliseconds: 200));
+      position = 2.0;
+      now = noon.add(const Duration(milliseconds: 2700));
+      expect(monitor.sample(), const Duration(milliseconds: 700));
+      expect(monitor.current, const Duration(milliseconds: 700));
+      expect(monitor.smoothed, const Duration(milliseconds: 300));
+      expect(monitor.max, const Duration(milliseconds: 700));
+      expect(monitor.sampleCount, 2);
+      expect(monitor.isAboveTarget, isFalse);
+      monitor.close();
+    });
+
+    test('FFplayKitInteractiveTest LowLatencyUdp', () async {
+      final port = 20000 + DateTime.now().millisecond * 10;
+      final url = 'udp://127.0.0.1:$port';
+
+      // Start the receiver first so that it sees the stream from pts 0.
+      final session = await FFplayKit.executeLive(
+        url,
+        options: ['-loglevel', 'fatal'],
+      );
+      await Future.delayed(const Duration(seconds: 1));
+
+      final senderStart = DateTime.now();
+      final sender = FFmpegSession.fromArguments([
+        '-hide_banner',
+        '-loglevel',
+        'error',
+        '-re',
+        '-f',
+        'lavfi',
+        '-i',
+        'testsrc=size=320x240:rate=30',
+        '-t',
+        '8',
+        '-c:v',
+        'mpeg2video',
+        '-g',
+        '15',
+        '-bf',
+        '0',
+        '-muxdelay',
+        '0',
+        '-muxpreload',
+        '0',
+        '-f',
+        'mpegts',
+        '$url?pkt_size=1316',
+      ]).executeAsync();
+
+      final monitor = session.monitorLatency(
+        FFplayLiveReference.anchored(0.0, senderStart),
+      );
+      final samples = <Duration>[];
+      final sub = monitor.latencyStream.listen(samples.add);
+      await Future.delayed(const Duration(seconds: 5));
+      await sub.cancel();
+
+      if (kDebugMode) print('Live latency: $monitor');
+      expect(samples, isNotEmpty);
+      expect(monitor.smoothed!.inMilliseconds, lessThan(1500));
+      expect(monitor.smoothed!.inMilliseconds, greaterThan(-200));
+
+      await sender;
+      session.cancel();
+    });
+  });
 }
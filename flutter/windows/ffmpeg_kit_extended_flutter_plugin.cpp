@@ -11,8 +11,14 @@
 #include <flutter/standard_method_codec.h>
 #include <windows.h>
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
 #include <cstring>
+#include <iterator>
 #include <mutex>
+#include <string>
 
 // --- FFmpegKit ABI (runtime-resolved) ----------------------------------------
 // Resolve the frame-callback symbols at runtime via GetProcAddress so that the
@@ -25,11 +31,13 @@ typedef void (*FFplayKitFrameCallback)(void* userdata, const uint8_t* pixels,
 
 namespace {
 
-using RegisterFn   = void (*)(FFplayKitFrameCallback, void*);
-using UnregisterFn = void (*)();
+using RegisterFn    = void (*)(FFplayKitFrameCallback, void*);
+using UnregisterFn  = void (*)();
+using GetPositionFn = double (*)();
 
-static RegisterFn   g_register_fn   = nullptr;
-static UnregisterFn g_unregister_fn = nullptr;
+static RegisterFn    g_register_fn     = nullptr;
+static UnregisterFn  g_unregister_fn   = nullptr;
+static GetPositionFn g_get_position_fn = nullptr;
 static std::once_flag g_resolve_once;
 
 static void ResolveFFplayProcs() {
@@ -56,6 +64,8 @@ static void ResolveFFplayProcs() {
           ::GetProcAddress(h, "ffplay_kit_register_frame_callback"));
       g_unregister_fn = reinterpret_cast<UnregisterFn>(
           ::GetProcAddress(h, "ffplay_kit_unregister_frame_callback"));
+      g_get_position_fn = reinterpret_cast<GetPositionFn>(
+          ::GetProcAddress(h, "ffplay_kit_get_position"));
 
       // Probe additional symbols to confirm the DLL export table is complete.
       auto video_w_fn =
@@ -95,10 +105,155 @@ static void ffplay_kit_unregister_frame_callback() {
   if (g_unregister_fn) g_unregister_fn();
 }
 
+// Master-clock position of the presented frame, or -1 when unknown (NaN
+// during a seek).
+static int64_t ffplay_kit_position_ms() {
+  ResolveFFplayProcs();
+  if (!g_get_position_fn) return -1;
+  double pos = g_get_position_fn();
+  if (std::isnan(pos) || pos < 0) return -1;
+  return static_cast<int64_t>(std::llround(pos * 1000.0));
+}
+
+template <typename T>
+static bool LookupArg(const flutter::EncodableMap& args, const char* key,
+                      T* out) {
+  auto it = args.find(flutter::EncodableValue(key));
+  if (it == args.end()) return false;
+  if (const auto* v = std::get_if<T>(&it->second)) {
+    *out = *v;
+    return true;
+  }
+  // StandardMethodCodec encodes small Dart ints as int32.
+  if (const auto* v = std::get_if<int32_t>(&it->second)) {
+    *out = static_cast<T>(*v);
+    return true;
+  }
+  return false;
+}
+
 }  // namespace
 
 namespace ffmpeg_kit_extended_flutter {
 
+// --- FrameCache ----------------------------------------------------------------
+
+void FrameCache::Configure(size_t max, int factor) {
+  max_bytes = max;
+  downscale = (std::max)(1, factor);
+  Clear();
+  hits = misses = evictions = 0;
+}
+
+void FrameCache::Clear() {
+  lru.clear();
+  index.clear();
+  bytes = 0;
+}
+
+void FrameCache::Insert(int64_t position_ms, const uint8_t* pixels, int width,
+                        int height, int linesize) {
+  if (!enabled() || position_ms < 0) return;
+  uint32_t w = static_cast<uint32_t>((std::max)(1, width / downscale));
+  uint32_t h = static_cast<uint32_t>((std::max)(1, height / downscale));
+  size_t size = static_cast<size_t>(w) * h * 4;
+  if (size > max_bytes) return;
+
+  auto existing = index.find(position_ms);
+  if (existing != index.end()) {
+    bytes -= existing->second->pixels.size();
+    lru.erase(existing->second);
+    index.erase(existing);
+  }
+  while (bytes + size > max_bytes && !lru.empty()) {
+    bytes -= lru.back().pixels.size();
+    index.erase(lru.back().position_ms);
+    lru.pop_back();
+    ++evictions;
+  }
+
+  CachedFrame frame;
+  frame.position_ms = position_ms;
+  frame.width = w;
+  frame.height = h;
+  frame.pixels.resize(size);
+  for (uint32_t y = 0; y < h; ++y) {
+    const uint8_t* src =
+        pixels + static_cast<size_t>(y) * downscale * linesize;
+    uint8_t* dst = frame.pixels.data() + static_cast<size_t>(y) * w * 4;
+    if (downscale == 1) {
+      memcpy(dst, src, static_cast<size_t>(w) * 4);
+    } else {
+      for (uint32_t x = 0; x < w; ++x) {
+        memcpy(dst + x * 4, src + static_cast<size_t>(x) * downscale * 4, 4);
+      }
+    }
+  }
+  lru.push_front(std::move(frame));
+  index[position_ms] = lru.begin();
+  bytes += size;
+}
+
+const CachedFrame* FrameCache::Find(int64_t position_ms,
+                                    int64_t tolerance_ms) {
+  auto best = index.end();
+  auto after = index.lower_bound(position_ms);
+  if (after != index.end()) best = after;
+  if (after != index.begin()) {
+    auto before = std::prev(after);
+    if (best == index.end() ||
+        position_ms - before->first < best->first - position_ms) {
+      best = before;
+    }
+  }
+  if (best == index.end() ||
+      std::llabs(best->first - position_ms) > tolerance_ms) {
+    ++misses;
+    return nullptr;
+  }
+  ++hits;
+  lru.splice(lru.begin(), lru, best->second);
+  return &*best->second;
+}
+
+// --- Presentation queue --------------------------------------------------------
+
+static int64_t SteadyMicros() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+void PresentationStats::OnArrival(int64_t now_us) {
+  if (last_arrival_us > 0) {
+    double interval = static_cast<double>(now_us - last_arrival_us);
+    frame_interval_us = frame_interval_us == 0
+                            ? interval
+                            : frame_interval_us * 0.9 + interval * 0.1;
+  }
+  last_arrival_us = now_us;
+  ++received;
+}
+
+void PresentationStats::OnPresent(const QueuedFrame& frame, int64_t now_us) {
+  int64_t latency = now_us - frame.decoded_us;
+  last_latency_us = latency;
+  max_latency_us = (std::max)(max_latency_us, latency);
+  total_latency_us += latency;
+  double limit = frame_interval_us * 1.5;
+  if (last_present_us > 0 && limit > 0 && now_us - last_present_us > limit &&
+      frame.decoded_us - last_present_us <= limit) {
+    ++janks;
+  }
+  last_present_us = now_us;
+  last_position_ms = frame.position_ms;
+  ++presented;
+}
+
+void TextureState::Recycle(std::vector<uint8_t>&& buf) {
+  if (spare.size() <= queue_depth) spare.push_back(std::move(buf));
+}
+
 // --- Frame callback (FFplay background thread) --------------------------------
 
 static void OnFrameCallback(void* userdata, const uint8_t* pixels, int width,
@@ -106,28 +261,56 @@ static void OnFrameCallback(void* userdata, const uint8_t* pixels, int width,
   auto* state = reinterpret_cast<TextureState*>(userdata);
   if (!state || !pixels || width <= 0 || height <= 0) return;
 
+  // Query the player before taking the plugin lock, so the callback never
+  // re-enters ffplay while holding a lock the method handlers also take.
+  int64_t now_us = SteadyMicros();
+  int64_t position_ms = ffplay_kit_position_ms();
+
   {
     std::lock_guard<std::mutex> lock(state->mutex);
     // Early exit if texture is being destroyed
     if (state->destroyed) {
       return;
     }
+    std::vector<uint8_t> buf;
+    if (!state->spare.empty()) {
+      buf = std::move(state->spare.back());
+      state->spare.pop_back();
+    }
     size_t row_bytes = static_cast<size_t>(linesize);
-    state->write_buf.resize(row_bytes * static_cast<size_t>(height));
-    memcpy(state->write_buf.data(), pixels, state->write_buf.size());
+    buf.assign(pixels, pixels + row_bytes * static_cast<size_t>(height));
     if (pixel_format && strcmp(pixel_format, "rgb0") == 0) {
-      uint8_t* buf = state->write_buf.data();
+      uint8_t* data = buf.data();
       for (int y = 0; y < height; y++) {
         for (int x = 0; x < width; x++) {
-          buf[y * linesize + x * 4 + 3] = 0xFF;
+          data[y * linesize + x * 4 + 3] = 0xFF;
         }
       }
     }
-    state->width = static_cast<uint32_t>(width);
-    state->height = static_cast<uint32_t>(height);
-    // Swap write_buf <-> read_buf so the render callback always gets the latest
-    // complete frame without blocking the decoder thread.
-    std::swap(state->write_buf, state->read_buf);
+
+    state->stats.OnArrival(now_us);
+    if (state->frame_cache.enabled()) {
+      state->frame_cache.Insert(position_ms, buf.data(), width, height,
+                                linesize);
+    }
+
+    if (state->queue.size() >= state->queue_depth) {
+      ++state->stats.dropped;
+      if (state->drop_newest) {
+        state->Recycle(std::move(buf));
+        return;
+      }
+      state->Recycle(std::move(state->queue.front().pixels));
+      state->queue.pop_front();
+    }
+
+    QueuedFrame frame;
+    frame.pixels = std::move(buf);
+    frame.width = static_cast<uint32_t>(width);
+    frame.height = static_cast<uint32_t>(height);
+    frame.position_ms = position_ms;
+    frame.decoded_us = now_us;
+    state->queue.push_back(std::move(frame));
     state->texture_registrar->MarkTextureFrameAvailable(state->texture_id);
   }
 }
@@ -139,12 +322,35 @@ static const FlutterDesktopPixelBuffer* CopyPixelBuffer(size_t /*width*/,
                                                          void* userdata) {
   auto* state = reinterpret_cast<TextureState*>(userdata);
   std::lock_guard<std::mutex> lock(state->mutex);
-  if (state->read_buf.empty() || state->width == 0 || state->height == 0)
+
+  // Take the next frame into render_buf: the oldest when every frame is
+  // presented, otherwise the newest, dropping the ones behind it.  render_buf
+  // is only touched on the render thread, so the pointer handed to Flutter
+  // stays stable after the mutex is released.  With nothing queued the last
+  // frame is re-shown.
+  if (!state->queue.empty()) {
+    if (!state->drop_newest) {
+      while (state->queue.size() > 1) {
+        ++state->stats.dropped;
+        state->Recycle(std::move(state->queue.front().pixels));
+        state->queue.pop_front();
+      }
+    }
+    QueuedFrame& frame = state->queue.front();
+    state->stats.OnPresent(frame, SteadyMicros());
+    state->render_buf.swap(frame.pixels);
+    state->width = frame.width;
+    state->height = frame.height;
+    state->Recycle(std::move(frame.pixels));
+    state->queue.pop_front();
+    // Frames still queued are presented on the following vsyncs.
+    if (!state->queue.empty()) {
+      state->texture_registrar->MarkTextureFrameAvailable(state->texture_id);
+    }
+  }
+  if (state->render_buf.empty() || state->width == 0 || state->height == 0)
     return nullptr;
 
-  // Copy under the mutex so render_buf.data() remains stable after we return
-  // and the mutex is released (OnFrameCallback may swap read_buf at any time).
-  state->render_buf = state->read_buf;
   state->pixel_buffer.buffer = state->render_buf.data();
   state->pixel_buffer.width = state->width;
   state->pixel_buffer.height = state->height;
@@ -183,15 +389,26 @@ void FfmpegKitExtendedFlutterPlugin::HandleMethodCall(
     const flutter::MethodCall<flutter::EncodableValue>& method_call,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
   if (method_call.method_name() == "createTexture") {
-    HandleCreateTexture(std::move(result));
+    HandleCreateTexture(method_call, std::move(result));
   } else if (method_call.method_name() == "releaseTexture") {
     HandleReleaseTexture(method_call, std::move(result));
+  } else if (method_call.method_name() == "configureFrameCache") {
+    HandleConfigureFrameCache(method_call, std::move(result));
+  } else if (method_call.method_name() == "showCachedFrame") {
+    HandleShowCachedFrame(method_call, std::move(result));
+  } else if (method_call.method_name() == "getFrameCacheStats") {
+    HandleGetFrameCacheStats(std::move(result));
+  } else if (method_call.method_name() == "getPresentationStats") {
+    HandleGetPresentationStats(std::move(result));
+  } else if (method_call.method_name() == "setFrameDelivery") {
+    HandleSetFrameDelivery(method_call, std::move(result));
   } else {
     result->NotImplemented();
   }
 }
 
 void FfmpegKitExtendedFlutterPlugin::HandleCreateTexture(
+    const flutter::MethodCall<flutter::EncodableValue>& method_call,
     std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
   // Release any existing texture before creating a new one.
   ReleaseTextureState();
@@ -199,6 +416,19 @@ void FfmpegKitExtendedFlutterPlugin::HandleCreateTexture(
   auto state = std::make_unique<TextureState>();
   state->texture_registrar = texture_registrar_;
 
+  if (const auto* args =
+          std::get_if<flutter::EncodableMap>(method_call.arguments())) {
+    int64_t queue_depth = 1;
+    LookupArg(*args, "queueDepth", &queue_depth);
+    state->queue_depth =
+        static_cast<size_t>(std::clamp<int64_t>(queue_depth, 1, 16));
+    auto policy = args->find(flutter::EncodableValue("dropPolicy"));
+    if (policy != args->end()) {
+      const auto* name = std::get_if<std::string>(&policy->second);
+      state->drop_newest = name && *name == "dropNewest";
+    }
+  }
+
   // Build the TextureVariant with a PixelBufferTexture.  The lambda captures
   // the raw state pointer; the TextureVariant is owned by the TextureState so
   // it is always destroyed before the state itself.
@@ -255,6 +485,164 @@ void FfmpegKitExtendedFlutterPlugin::HandleReleaseTexture(
   result->Success();
 }
 
+void FfmpegKitExtendedFlutterPlugin::HandleConfigureFrameCache(
+    const flutter::MethodCall<flutter::EncodableValue>& method_call,
+    std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
+  const auto* args = std::get_if<flutter::EncodableMap>(method_call.arguments());
+  int64_t max_bytes = 0;
+  int64_t downscale = 1;
+  if (!args || !LookupArg(*args, "maxBytes", &max_bytes) || max_bytes < 0) {
+    result->Error("INVALID_ARGUMENT", "Expected maxBytes integer >= 0");
+    return;
+  }
+  LookupArg(*args, "downscale", &downscale);
+  if (!texture_state_) {
+    result->Error("NO_TEXTURE", "No texture has been created");
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(texture_state_->mutex);
+    texture_state_->frame_cache.Configure(static_cast<size_t>(max_bytes),
+                                          static_cast<int>(downscale));
+  }
+  result->Success();
+}
+
+void FfmpegKitExtendedFlutterPlugin::HandleShowCachedFrame(
+    const flutter::MethodCall<flutter::EncodableValue>& method_call,
+    std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
+  const auto* args = std::get_if<flutter::EncodableMap>(method_call.arguments());
+  int64_t position_ms = 0;
+  int64_t tolerance_ms = 0;
+  if (!args || !LookupArg(*args, "positionMs", &position_ms)) {
+    result->Error("INVALID_ARGUMENT", "Expected positionMs integer");
+    return;
+  }
+  LookupArg(*args, "toleranceMs", &tolerance_ms);
+
+  flutter::EncodableMap reply;
+  bool hit = false;
+  if (texture_state_) {
+    TextureState* state = texture_state_.get();
+    std::lock_guard<std::mutex> lock(state->mutex);
+    const CachedFrame* frame =
+        state->destroyed || !state->frame_cache.enabled()
+            ? nullptr
+            : state->frame_cache.Find(position_ms, tolerance_ms);
+    if (frame) {
+      // Replace anything queued so the cached frame is presented next.
+      while (!state->queue.empty()) {
+        state->Recycle(std::move(state->queue.front().pixels));
+        state->queue.pop_front();
+      }
+      QueuedFrame shown;
+      shown.pixels = frame->pixels;
+      shown.width = frame->width;
+      shown.height = frame->height;
+      shown.position_ms = frame->position_ms;
+      shown.decoded_us = SteadyMicros();
+      state->queue.push_back(std::move(shown));
+      state->texture_registrar->MarkTextureFrameAvailable(state->texture_id);
+      reply[flutter::EncodableValue("positionMs")] =
+          flutter::EncodableValue(frame->position_ms);
+      hit = true;
+    }
+  }
+  reply[flutter::EncodableValue("hit")] = flutter::EncodableValue(hit);
+  result->Success(flutter::EncodableValue(reply));
+}
+
+void FfmpegKitExtendedFlutterPlugin::HandleGetFrameCacheStats(
+    std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
+  flutter::EncodableMap reply;
+  if (texture_state_) {
+    std::lock_guard<std::mutex> lock(texture_state_->mutex);
+    const FrameCache& cache = texture_state_->frame_cache;
+    auto put = [&reply](const char* key, int64_t value) {
+      reply[flutter::EncodableValue(key)] = flutter::EncodableValue(value);
+    };
+    put("maxBytes", static_cast<int64_t>(cache.max_bytes));
+    put("bytes", static_cast<int64_t>(cache.bytes));
+    put("entries", static_cast<int64_t>(cache.lru.size()));
+    put("hits", static_cast<int64_t>(cache.hits));
+    put("misses", static_cast<int64_t>(cache.misses));
+    put("evictions", static_cast<int64_t>(cache.evictions));
+    if (!cache.index.empty()) {
+      put("firstMs", cache.index.begin()->first);
+      put("lastMs", cache.index.rbegin()->first);
+    }
+  }
+  result->Success(flutter::EncodableValue(reply));
+}
+
+void FfmpegKitExtendedFlutterPlugin::HandleGetPresentationStats(
+    std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
+  flutter::EncodableMap reply;
+  if (texture_state_) {
+    std::lock_guard<std::mutex> lock(texture_state_->mutex);
+    const TextureState& state = *texture_state_;
+    const PresentationStats& stats = state.stats;
+    auto put = [&reply](const char* key, int64_t value) {
+      reply[flutter::EncodableValue(key)] = flutter::EncodableValue(value);
+    };
+    put("queueDepth", static_cast<int64_t>(state.queue_depth));
+    reply[flutter::EncodableValue("dropPolicy")] = flutter::EncodableValue(
+        std::string(state.drop_newest ? "dropNewest" : "dropOldest"));
+    put("queued", static_cast<int64_t>(state.queue.size()));
+    put("received", static_cast<int64_t>(stats.received));
+    put("presented", static_cast<int64_t>(stats.presented));
+    put("dropped", static_cast<int64_t>(stats.dropped));
+    put("janks", static_cast<int64_t>(stats.janks));
+    put("lastLatencyUs", stats.last_latency_us);
+    put("maxLatencyUs", stats.max_latency_us);
+    put("averageLatencyUs",
+        stats.presented
+            ? stats.total_latency_us / static_cast<int64_t>(stats.presented)
+            : 0);
+    put("frameIntervalUs", static_cast<int64_t>(stats.frame_interval_us));
+    put("lastPositionMs", stats.last_position_ms);
+  }
+  result->Success(flutter::EncodableValue(reply));
+}
+
+// Stops or restarts frame delivery for a hidden view.  While stopped the
+// decoder thread never calls into the plugin and nothing is marked available;
+// the texture keeps showing the last presented frame.
+void FfmpegKitExtendedFlutterPlugin::HandleSetFrameDelivery(
+    const flutter::MethodCall<flutter::EncodableValue>& method_call,
+    std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result) {
+  const auto* args = std::get_if<flutter::EncodableMap>(method_call.arguments());
+  const bool* enabled = nullptr;
+  if (args) {
+    auto it = args->find(flutter::EncodableValue("enabled"));
+    if (it != args->end()) enabled = std::get_if<bool>(&it->second);
+  }
+  if (!enabled) {
+    result->Error("INVALID_ARGUMENT", "Expected enabled boolean");
+    return;
+  }
+  if (texture_state_) {
+    TextureState* state = texture_state_.get();
+    bool changed = false;
+    {
+      std::lock_guard<std::mutex> lock(state->mutex);
+      changed = !state->destroyed && state->delivering != *enabled;
+      if (changed) state->delivering = *enabled;
+    }
+    if (changed && *enabled) {
+      ffplay_kit_register_frame_callback(OnFrameCallback, state);
+    } else if (changed) {
+      ffplay_kit_unregister_frame_callback();
+      std::lock_guard<std::mutex> lock(state->mutex);
+      while (!state->queue.empty()) {
+        state->Recycle(std::move(state->queue.front().pixels));
+        state->queue.pop_front();
+      }
+    }
+  }
+  result->Success();
+}
+
 void FfmpegKitExtendedFlutterPlugin::ReleaseTextureState() {
   if (!texture_state_) return;
 
@@ -273,9 +661,10 @@ void FfmpegKitExtendedFlutterPlugin::ReleaseTextureState() {
     // Mark as destroyed while holding the mutex to ensure no concurrent access
     state_to_release->destroyed = true;
     // Clear state while holding the mutex to ensure no concurrent access
-    state_to_release->write_buf.clear();
-    state_to_release->read_buf.clear();
+    state_to_release->queue.clear();
+    state_to_release->spare.clear();
     state_to_release->render_buf.clear();
+    state_to_release->frame_cache.Clear();
     state_to_release->width = 0;
     state_to_release->height = 0;
   }
@@ -6,6 +6,9 @@
 #include <flutter/texture_registrar.h>
 
 #include <cstdint>
+#include <deque>
+#include <list>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <vector>
@@ -29,22 +32,95 @@ FLUTTER_PLUGIN_EXPORT void FfmpegKitExtendedFlutterPluginRegisterWithRegistrar(
 
 namespace ffmpeg_kit_extended_flutter {
 
+// --- Frame cache ----------------------------------------------------------------
+
+// A presented RGBA frame, possibly downscaled, with tightly packed rows.
+struct CachedFrame {
+  int64_t position_ms = 0;
+  uint32_t width = 0;
+  uint32_t height = 0;
+  std::vector<uint8_t> pixels;
+};
+
+// Bounded LRU of recently presented frames keyed by presentation position in
+// milliseconds, used to answer scrubbing seeks without decoding.  Guarded by
+// TextureState::mutex.
+struct FrameCache {
+  size_t max_bytes = 0;  // 0 disables the cache
+  int downscale = 1;
+  size_t bytes = 0;
+  uint64_t hits = 0;
+  uint64_t misses = 0;
+  uint64_t evictions = 0;
+  std::list<CachedFrame> lru;  // front = most recently used
+  std::map<int64_t, std::list<CachedFrame>::iterator> index;
+
+  bool enabled() const { return max_bytes > 0; }
+
+  // Sets the byte budget and downscale factor, dropping cached frames and
+  // statistics.
+  void Configure(size_t max, int factor);
+  void Clear();
+  void Insert(int64_t position_ms, const uint8_t* pixels, int width,
+              int height, int linesize);
+  // Returns the frame nearest to position_ms within tolerance_ms, or nullptr.
+  const CachedFrame* Find(int64_t position_ms, int64_t tolerance_ms);
+};
+
+// --- Presentation queue --------------------------------------------------------
+
+// A decoded frame waiting for the render thread, stamped with the player
+// position and the steady-clock time (us) the frame callback received it.
+struct QueuedFrame {
+  std::vector<uint8_t> pixels;
+  uint32_t width = 0;
+  uint32_t height = 0;
+  int64_t position_ms = -1;
+  int64_t decoded_us = 0;
+};
+
+// Decode-to-display latency, drop, and jank counters.  A jank is a frame that
+// was decoded in time but presented more than 1.5 frame intervals after the
+// previous one; gaps caused by the decoder itself (pause, stall) don't count.
+// Guarded by TextureState::mutex.
+struct PresentationStats {
+  uint64_t received = 0;
+  uint64_t presented = 0;
+  uint64_t dropped = 0;
+  uint64_t janks = 0;
+  int64_t last_latency_us = 0;
+  int64_t max_latency_us = 0;
+  int64_t total_latency_us = 0;
+  int64_t last_position_ms = -1;
+  int64_t last_arrival_us = 0;
+  int64_t last_present_us = 0;
+  double frame_interval_us = 0;  // smoothed arrival interval
+
+  void OnArrival(int64_t now_us);
+  void OnPresent(const QueuedFrame& frame, int64_t now_us);
+};
+
 // --- Pixel-buffer texture state -----------------------------------------------
 
 // Holds the mutable state shared between the FFplay frame callback (background
 // thread) and Flutter's CopyPixelBuffer callback (render thread).
 //
-// Double-buffer strategy: the frame callback writes into write_buf then swaps
-// with read_buf under the mutex, so the render callback always reads the latest
-// complete frame without blocking the decoder thread.
+// The frame callback appends to a bounded queue under the mutex and the render
+// callback takes the oldest frame, so the decoder thread never waits for the
+// render thread.  When the queue is full the oldest frame is dropped (lowest
+// latency) unless drop_newest is set, in which case the incoming frame is
+// dropped so that queued frames are all presented.
 struct TextureState {
   flutter::TextureRegistrar* texture_registrar;  // not owned
   std::unique_ptr<flutter::TextureVariant> texture_variant;
   int64_t texture_id = -1;
 
   std::mutex mutex;
-  std::vector<uint8_t> write_buf;
-  std::vector<uint8_t> read_buf;
+  std::deque<QueuedFrame> queue;
+  std::vector<std::vector<uint8_t>> spare;  // recycled pixel buffers
+  size_t queue_depth = 1;
+  bool drop_newest = false;
+  bool delivering = true;  // frame callback registered
   // render_buf is written only on the render thread (CopyPixelBuffer) so the
   // pointer returned to Flutter remains stable after the mutex is released.
   std::vector<uint8_t> render_buf;
@@ -54,6 +130,12 @@ struct TextureState {
   // Stable FlutterDesktopPixelBuffer returned by CopyPixelBuffer.
   FlutterDesktopPixelBuffer pixel_buffer{};
   bool destroyed = false;            // Flag to indicate texture is being destroyed
+
+  FrameCache frame_cache;
+  PresentationStats stats;
+
+  // Returns a pixel buffer to the spare pool, bounded by queue_depth.
+  void Recycle(std::vector<uint8_t>&& buf);
 };
 
 // --- Plugin class -------------------------------------------------------------
@@ -78,10 +160,24 @@ class FfmpegKitExtendedFlutterPlugin : public flutter::Plugin {
       std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
 
   void HandleCreateTexture(
+      const flutter::MethodCall<flutter::EncodableValue>& method_call,
       std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
   void HandleReleaseTexture(
       const flutter::MethodCall<flutter::EncodableValue>& method_call,
       std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
+  void HandleConfigureFrameCache(
+      const flutter::MethodCall<flutter::EncodableValue>& method_call,
+      std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
+  void HandleShowCachedFrame(
+      const flutter::MethodCall<flutter::EncodableValue>& method_call,
+      std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
+  void HandleGetFrameCacheStats(
+      std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
+  void HandleGetPresentationStats(
+      std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
+  void HandleSetFrameDelivery(
+      const flutter::MethodCall<flutter::EncodableValue>& method_call,
+      std::unique_ptr<flutter::MethodResult<flutter::EncodableValue>> result);
   void ReleaseTextureState();
 
   flutter::TextureRegistrar* texture_registrar_ = nullptr;